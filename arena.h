@@ -0,0 +1,117 @@
+//
+// Arena: growable array of objects in fixed-size chunks, with stable addresses.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//
+// Array of objects, allocated in chunks of fixed size.
+// Objects never move, so they can be linked by pointers,
+// and are addressed by 32-bit index: chunk number and offset.
+// Memory is allocated once per chunk, not per object,
+// and objects of a chunk are contiguous, for fast iteration.
+//
+template <typename T, unsigned CHUNK_SIZE = 256>
+class arena_t {
+    static_assert((CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "chunk size must be a power of 2");
+
+private:
+    // Raw memory for objects.
+    struct chunk_t {
+        alignas(T) unsigned char storage[CHUNK_SIZE * sizeof(T)];
+    };
+    std::vector<std::unique_ptr<chunk_t>> chunks; // Allocated chunks
+    uint32_t count{ 0 };                          // Number of objects
+
+    // Get address of the object with given index.
+    T *address(uint32_t i) const
+    {
+        return std::launder(reinterpret_cast<T *>(chunks[i / CHUNK_SIZE]->storage) +
+                            i % CHUNK_SIZE);
+    }
+
+public:
+    // Empty arena.
+    arena_t() = default;
+
+    // Forbid the copy constructor.
+    arena_t(const arena_t &) = delete;
+
+    // Destroy all objects.
+    ~arena_t()
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            address(i)->~T();
+        }
+    }
+
+    // Get number of objects.
+    uint32_t size() const { return count; }
+
+    // Get object by index.
+    T &operator[](uint32_t i) { return *address(i); }
+    const T &operator[](uint32_t i) const { return *address(i); }
+
+    // Construct a new object at the end.
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (count % CHUNK_SIZE == 0)
+            chunks.push_back(std::make_unique<chunk_t>());
+        T *p = new (address(count)) T(std::forward<Args>(args)...);
+        count++;
+        return *p;
+    }
+
+    //
+    // Iteration over all objects, in order of index.
+    //
+    template <typename A, typename V>
+    class iterator_t {
+    private:
+        A *arena;   // Arena to iterate
+        uint32_t i; // Current index
+
+    public:
+        iterator_t(A *a, uint32_t n) : arena(a), i(n) {}
+        V &operator*() const { return (*arena)[i]; }
+        iterator_t &operator++()
+        {
+            i++;
+            return *this;
+        }
+        bool operator!=(const iterator_t &b) const { return i != b.i; }
+    };
+    using iterator = iterator_t<arena_t, T>;
+    using const_iterator = iterator_t<const arena_t, const T>;
+
+    iterator begin() { return { this, 0 }; }
+    iterator end() { return { this, count }; }
+    const_iterator begin() const { return { this, 0 }; }
+    const_iterator end() const { return { this, count }; }
+};
@@ -0,0 +1,264 @@
+//
+// Bit vector of arbitrary width, for wide buses.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+//
+// Vector of N bits, stored in 64-bit words, least significant word first.
+// Unused bits of the top word are always zero, so that vectors
+// can be compared with memcmp(), which is vectorized in the C library.
+// All operations are word-parallel loops, which the compiler can vectorize.
+// The type is trivially copyable, and can be used as a value of typed_signal_t.
+//
+template <unsigned N>
+class bitvec {
+    static_assert(N > 0, "bit vector cannot be empty");
+
+public:
+    static constexpr unsigned num_words = (N + 63) / 64; // Size in 64-bit words
+
+private:
+    // Bits, low word first; aligned for vector loads, but without padding.
+    alignas(num_words % 4 == 0 ? 32 : num_words % 2 == 0 ? 16 : 8) uint64_t words[num_words]{};
+
+    // Clear unused bits of the top word.
+    constexpr void trim()
+    {
+        if constexpr (N % 64 != 0)
+            words[num_words - 1] &= (uint64_t(1) << (N % 64)) - 1;
+    }
+
+public:
+    // Zero value.
+    constexpr bitvec() = default;
+
+    // Value from integer, truncated to N bits.
+    constexpr bitvec(uint64_t v)
+    {
+        words[0] = v;
+        trim();
+    }
+
+    // Get width in bits.
+    static constexpr unsigned width() { return N; }
+
+    // Get or set a word.
+    constexpr uint64_t word(unsigned i) const { return words[i]; }
+    constexpr void set_word(unsigned i, uint64_t v)
+    {
+        words[i] = v;
+        if (i == num_words - 1)
+            trim();
+    }
+
+    // Get or set a bit.
+    constexpr bool bit(unsigned i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    constexpr void set_bit(unsigned i, bool v)
+    {
+        uint64_t mask = uint64_t(1) << (i % 64);
+        words[i / 64] = v ? (words[i / 64] | mask) : (words[i / 64] & ~mask);
+    }
+
+    // Get low 64 bits.
+    constexpr uint64_t to_uint64() const { return words[0]; }
+
+    // Check whether any bit is set.
+    constexpr bool any() const
+    {
+        uint64_t acc = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+            acc |= words[i];
+        }
+        return acc != 0;
+    }
+
+    //
+    // Bitwise operations.
+    //
+    constexpr bitvec &operator&=(const bitvec &v)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            words[i] &= v.words[i];
+        }
+        return *this;
+    }
+
+    constexpr bitvec &operator|=(const bitvec &v)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            words[i] |= v.words[i];
+        }
+        return *this;
+    }
+
+    constexpr bitvec &operator^=(const bitvec &v)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            words[i] ^= v.words[i];
+        }
+        return *this;
+    }
+
+    constexpr bitvec operator~() const
+    {
+        bitvec r;
+        for (unsigned i = 0; i < num_words; i++) {
+            r.words[i] = ~words[i];
+        }
+        r.trim();
+        return r;
+    }
+
+    //
+    // Arithmetic modulo 2^N.
+    //
+    constexpr bitvec &operator+=(const bitvec &v)
+    {
+        uint64_t carry = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t sum = words[i] + carry;
+            carry = (sum < carry);
+            words[i] = sum + v.words[i];
+            carry += (words[i] < sum);
+        }
+        trim();
+        return *this;
+    }
+
+    constexpr bitvec &operator-=(const bitvec &v)
+    {
+        uint64_t borrow = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t a = words[i], b = v.words[i];
+            words[i] = a - b - borrow;
+            borrow = (a < b) || (a - b < borrow);
+        }
+        trim();
+        return *this;
+    }
+
+    //
+    // Shifts. Bits shifted out are lost, zeros are shifted in.
+    //
+    constexpr bitvec &operator<<=(unsigned n)
+    {
+        if (n >= N)
+            return *this = bitvec();
+
+        unsigned w = n / 64, b = n % 64;
+        for (unsigned i = num_words; i-- > 0;) {
+            uint64_t hi = (i >= w) ? words[i - w] : 0;
+            uint64_t lo = (i >= w + 1) ? words[i - w - 1] : 0;
+            words[i] = b ? (hi << b) | (lo >> (64 - b)) : hi;
+        }
+        trim();
+        return *this;
+    }
+
+    constexpr bitvec &operator>>=(unsigned n)
+    {
+        if (n >= N)
+            return *this = bitvec();
+
+        unsigned w = n / 64, b = n % 64;
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t lo = (i + w < num_words) ? words[i + w] : 0;
+            uint64_t hi = (i + w + 1 < num_words) ? words[i + w + 1] : 0;
+            words[i] = b ? (lo >> b) | (hi << (64 - b)) : lo;
+        }
+        return *this;
+    }
+
+    //
+    // Operands are passed by reference: vectors can be large.
+    //
+    friend constexpr bitvec operator&(const bitvec &a, const bitvec &b) { return bitvec(a) &= b; }
+    friend constexpr bitvec operator|(const bitvec &a, const bitvec &b) { return bitvec(a) |= b; }
+    friend constexpr bitvec operator^(const bitvec &a, const bitvec &b) { return bitvec(a) ^= b; }
+    friend constexpr bitvec operator+(const bitvec &a, const bitvec &b) { return bitvec(a) += b; }
+    friend constexpr bitvec operator-(const bitvec &a, const bitvec &b) { return bitvec(a) -= b; }
+    friend constexpr bitvec operator<<(const bitvec &a, unsigned n) { return bitvec(a) <<= n; }
+    friend constexpr bitvec operator>>(const bitvec &a, unsigned n) { return bitvec(a) >>= n; }
+
+    // Compare all words at once.
+    friend bool operator==(const bitvec &a, const bitvec &b)
+    {
+        return std::memcmp(a.words, b.words, sizeof(a.words)) == 0;
+    }
+
+    //
+    // Zero-extend or truncate to M bits.
+    //
+    template <unsigned M>
+    constexpr bitvec<M> resize() const
+    {
+        bitvec<M> r;
+        for (unsigned i = 0; i < r.num_words && i < num_words; i++) {
+            r.set_word(i, words[i]);
+        }
+        return r;
+    }
+
+    //
+    // Get bits from HI down to LO, like v[HI:LO] in Verilog.
+    //
+    template <unsigned HI, unsigned LO>
+    constexpr bitvec<HI - LO + 1> slice() const
+    {
+        static_assert(HI >= LO && HI < N, "slice out of range");
+        return (*this >> LO).template resize<HI - LO + 1>();
+    }
+
+    //
+    // Print as hex number.
+    //
+    std::string to_string() const
+    {
+        static const char hex[] = "0123456789abcdef";
+        std::string s;
+        for (unsigned i = (N + 3) / 4; i-- > 0;) {
+            s += hex[(words[i / 16] >> (i % 16 * 4)) & 15];
+        }
+        return s;
+    }
+};
+
+//
+// Concatenation, like {hi, lo} in Verilog.
+//
+template <unsigned N, unsigned M>
+constexpr bitvec<N + M> concat(const bitvec<N> &hi, const bitvec<M> &lo)
+{
+    return lo.template resize<N + M>() | (hi.template resize<N + M>() << M);
+}
+
+template <unsigned N>
+std::ostream &operator<<(std::ostream &out, const bitvec<N> &v)
+{
+    return out << v.to_string();
+}
@@ -0,0 +1,330 @@
+//
+// Checkpoints of the simulation, based on fork().
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "simulator.h"
+
+//
+// A checkpoint is a forked copy of the whole simulator process.
+// Memory pages are shared copy-on-write, so coroutine frames
+// are preserved without any knowledge of their layout.
+// The copy is blocked reading the command pipe:
+//
+//      'r'         - resume the simulation from the checkpoint;
+//      'q' or EOF  - terminate.
+//
+// When resumed, the copy forks once more: the simulation continues in the child,
+// while the copy waits for it, and writes its exit status to the status pipe.
+// The copy is not always a child of the process which called rewind(),
+// and waitpid() cannot be used then.
+//
+enum {
+    CMD_RESUME = 'r',
+    CMD_QUIT = 'q',
+};
+
+//
+// Create a pipe, which is closed on exec().
+//
+static bool make_pipe(int fd[2])
+{
+    if (pipe(fd) < 0)
+        return false;
+    fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+    return true;
+}
+
+//
+// Flush output buffers, so that they are not duplicated by fork().
+//
+static void flush_output()
+{
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+}
+
+//
+// Write one command byte to the pipe.
+//
+static void send_command(int fd, char cmd)
+{
+    while (write(fd, &cmd, 1) < 0 && errno == EINTR)
+        continue;
+}
+
+//
+// Wait until the write end of the pipe is closed by all processes.
+// Return exit status, reported by the resumed copy, or -1 when it has crashed.
+//
+static int wait_for_status(int fd)
+{
+    int status = -1;
+    char buf[sizeof(status)];
+    size_t count = 0;
+    for (;;) {
+        ssize_t n = read(fd, buf + count, sizeof(buf) - count);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        count += n;
+        if (count == sizeof(buf)) {
+            std::memcpy(&status, buf, sizeof(status));
+            count = 0;
+        }
+    }
+    return status;
+}
+
+//
+// Wait for the child process, if it's ours, and get the exit status.
+// A resumed checkpoint can own checkpoints of its parent:
+// those are not our children, and waitpid() fails.
+// Return false in this case.
+//
+static bool reap(int pid, int *status = nullptr)
+{
+    for (;;) {
+        if (waitpid(pid, status, 0) >= 0)
+            return true;
+        if (errno != EINTR)
+            return false;
+    }
+}
+
+//
+// Check whether the copy is still waiting for a command.
+// It's the only writer of its status pipe, and writes nothing until resumed:
+// the pipe becomes readable (at EOF) only when the copy has terminated.
+//
+static bool is_waiting(int status_fd)
+{
+    struct pollfd p = { status_fd, POLLIN, 0 };
+    return poll(&p, 1, 0) == 0;
+}
+
+//
+// Get exit code of a finished process, from the status of waitpid().
+// When killed by a signal, return 128+N, like a shell.
+//
+static int exit_code(int wait_status)
+{
+    if (WIFSIGNALED(wait_status))
+        return 128 + WTERMSIG(wait_status);
+    return WEXITSTATUS(wait_status);
+}
+
+//
+// Terminate the copy and remove it from the pool.
+//
+void simulator_t::drop_checkpoint(unsigned index)
+{
+    checkpoint_t &cp = checkpoints[index];
+
+    send_command(cp.command_fd, CMD_QUIT);
+    close(cp.command_fd);
+    close(cp.status_fd);
+    reap(cp.pid);
+    checkpoints.erase(checkpoints.begin() + index);
+}
+
+//
+// Set limit for the pool of checkpoints.
+// Drop the oldest ones, when needed.
+//
+void simulator_t::set_max_checkpoints(unsigned n)
+{
+    max_checkpoints = n;
+    while (checkpoints.size() > max_checkpoints) {
+        drop_checkpoint(0);
+    }
+}
+
+//
+// Take a checkpoint: fork() a copy of the simulator, which stays suspended
+// until rewind() is called.
+// Return false when the checkpoint is taken, and true in the resumed copy.
+//
+bool simulator_t::checkpoint()
+{
+    if (max_checkpoints == 0)
+        return false;
+
+    // Make room in the pool before fork(), so that the copy gets the same pool.
+    if (checkpoints.size() >= max_checkpoints) {
+        drop_checkpoint(0);
+    }
+
+    int command[2], status[2];
+    if (!make_pipe(command))
+        return false;
+    if (!make_pipe(status)) {
+        close(command[0]);
+        close(command[1]);
+        return false;
+    }
+
+    flush_output();
+    int pid = fork();
+    if (pid < 0) {
+        close(command[0]);
+        close(command[1]);
+        close(status[0]);
+        close(status[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        // Checkpoint: wait for a command.
+        close(command[1]);
+        close(status[0]);
+        for (;;) {
+            char cmd;
+            ssize_t n = read(command[0], &cmd, 1);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n == 1 && cmd == CMD_RESUME)
+                break;
+            _exit(0);
+        }
+
+        // Resumed: continue the simulation from this point, in a child process.
+        // Report its exit status to the status pipe, and exit the same way.
+        // When fork() fails, continue here: the status is known only to our parent.
+        close(command[0]);
+        int child = fork();
+        if (child > 0) {
+            for (auto &cp : checkpoints) {
+                close(cp.command_fd);
+                close(cp.status_fd);
+            }
+            int wait_status, code = EXIT_FAILURE;
+            if (reap(child, &wait_status))
+                code = exit_code(wait_status);
+            while (write(status[1], &code, sizeof(code)) < 0 && errno == EINTR)
+                continue;
+            _exit(code);
+        }
+        close(status[1]);
+
+        // Older checkpoints could be dropped by our parent after this one was taken.
+        for (unsigned i = 0; i < checkpoints.size();) {
+            if (is_waiting(checkpoints[i].status_fd)) {
+                i++;
+                continue;
+            }
+            close(checkpoints[i].command_fd);
+            close(checkpoints[i].status_fd);
+            checkpoints.erase(checkpoints.begin() + i);
+        }
+        return true;
+    }
+
+    // Add the copy to the pool.
+    close(command[0]);
+    close(status[1]);
+    checkpoints.push_back({ pid, command[1], status[0], time_ticks });
+    return false;
+}
+
+//
+// Resume the n-th latest checkpoint (1 = the most recent one).
+// Wait until the resumed simulation finishes, and exit.
+// Return false when there is no such checkpoint.
+//
+bool simulator_t::rewind(unsigned n)
+{
+    if (n == 0 || n > checkpoints.size())
+        return false;
+
+    // Newer checkpoints are not needed anymore.
+    while (n > 1) {
+        drop_checkpoint(checkpoints.size() - 1);
+        n--;
+    }
+
+    // Resume the copy. Older checkpoints are owned by it now.
+    checkpoint_t cp = checkpoints.back();
+    checkpoints.pop_back();
+    for (auto &older : checkpoints) {
+        close(older.command_fd);
+        close(older.status_fd);
+    }
+    checkpoints.clear();
+
+    flush_output();
+    send_command(cp.command_fd, CMD_RESUME);
+    close(cp.command_fd);
+    int status = wait_for_status(cp.status_fd);
+
+    // Exit the same way as the resumed copy.
+    int wait_status;
+    if (reap(cp.pid, &wait_status))
+        status = exit_code(wait_status);
+    std::exit(status < 0 ? EXIT_FAILURE : status);
+}
+
+//
+// Fork the simulator into a given number of branches, running in parallel.
+// Return branch number in each copy, or -1 in the original process.
+// When fork() fails, no more branches are started: wait for the started ones,
+// and return -2.
+//
+int simulator_t::fan_out(unsigned num_branches)
+{
+    std::vector<int> pids;
+
+    flush_output();
+    for (unsigned branch = 0; branch < num_branches; branch++) {
+        int pid = fork();
+        if (pid < 0)
+            break;
+        if (pid == 0) {
+            // Checkpoints belong to the original process.
+            for (auto &cp : checkpoints) {
+                close(cp.command_fd);
+                close(cp.status_fd);
+            }
+            checkpoints.clear();
+            return branch;
+        }
+        pids.push_back(pid);
+    }
+
+    for (int pid : pids) {
+        reap(pid);
+    }
+    return (pids.size() == num_branches) ? -1 : -2;
+}
@@ -0,0 +1,225 @@
+//
+// Coverage database: toggles of signals and activations of processes.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "coverage.h"
+
+#include <fstream>
+
+#include "simulator.h"
+
+//
+// Coverage file is binary, in native byte order:
+//
+//      "simcover" <version:u32>
+//      then for signals and for processes:
+//          <count:u32>
+//          <length:u32> <name>             -- names of items, in order of index
+//          <bits:u64> ...                  -- bitmap, two bits per item
+//
+static const char coverage_magic[8] = { 's', 'i', 'm', 'c', 'o', 'v', 'e', 'r' };
+static const uint32_t coverage_version = 1;
+
+//
+// Add an item, or merge bits to the item with the same name.
+//
+void coverage_t::add(int kind, const std::string &name, unsigned bits)
+{
+    table_t &table = tables[kind];
+    auto [it, inserted] = table.index.try_emplace(name, table.names.size());
+    uint32_t i = it->second;
+    if (inserted) {
+        table.names.push_back(name);
+        if (i % 32 == 0)
+            table.bits.push_back(0);
+    }
+    table.bits[i / 32] |= uint64_t(bits & 3) << (i % 32 * 2);
+}
+
+//
+// Get number of items, which have all the given bits.
+//
+size_t coverage_t::count(int kind, unsigned mask) const
+{
+    size_t n = 0;
+    for (size_t i = 0; i < size(kind); i++) {
+        if ((get(kind, i) & mask) == mask)
+            n++;
+    }
+    return n;
+}
+
+//
+// Merge coverage of another run.
+//
+void coverage_t::merge(const coverage_t &other)
+{
+    for (int kind : { SIGNALS, PROCESSES }) {
+        for (size_t i = 0; i < other.size(kind); i++) {
+            add(kind, other.name(kind, i), other.get(kind, i));
+        }
+    }
+}
+
+//
+// Write coverage to a binary file.
+// Return false on error.
+//
+bool coverage_t::save(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+        return false;
+
+    out.write(coverage_magic, sizeof(coverage_magic));
+    out.write((const char *)&coverage_version, sizeof(coverage_version));
+    for (auto &table : tables) {
+        uint32_t count = table.names.size();
+        out.write((const char *)&count, sizeof(count));
+        for (auto &name : table.names) {
+            uint32_t length = name.size();
+            out.write((const char *)&length, sizeof(length));
+            out.write(name.data(), length);
+        }
+        out.write((const char *)table.bits.data(), table.bits.size() * sizeof(uint64_t));
+    }
+    return bool(out);
+}
+
+//
+// Read a binary file, and merge it to the coverage.
+// Return false when the file is missing or corrupted:
+// in this case the coverage is not changed.
+//
+bool coverage_t::load(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+
+    char magic[sizeof(coverage_magic)];
+    uint32_t version;
+    if (!in.read(magic, sizeof(magic)) || !in.read((char *)&version, sizeof(version)) ||
+        !std::equal(magic, magic + sizeof(magic), coverage_magic) || version != coverage_version)
+        return false;
+
+    // Read the whole file before changing anything.
+    coverage_t run;
+    for (int kind : { SIGNALS, PROCESSES }) {
+        uint32_t count;
+        if (!in.read((char *)&count, sizeof(count)))
+            return false;
+
+        std::vector<std::string> names(count);
+        for (auto &name : names) {
+            uint32_t length;
+            if (!in.read((char *)&length, sizeof(length)))
+                return false;
+            name.resize(length);
+            if (!in.read(name.data(), length))
+                return false;
+        }
+        std::vector<uint64_t> bits((count + 31) / 32);
+        if (!in.read((char *)bits.data(), bits.size() * sizeof(uint64_t)))
+            return false;
+
+        for (uint32_t i = 0; i < count; i++) {
+            run.add(kind, names[i], (bits[i / 32] >> (i % 32 * 2)) & 3);
+        }
+    }
+    merge(run);
+    return true;
+}
+
+//
+// Start collecting coverage: toggles of signals, and activations of processes.
+// Edges of a signal are kept in the signal itself, as the commit phase
+// touches it anyway; when both edges have been seen, the signal costs nothing.
+// They are packed to the bitmap of the database by collect_coverage().
+//
+void simulator_t::enable_coverage()
+{
+    if (is_covering)
+        return;
+    is_covering = true;
+
+    for (signal_base_t *sig = signal_base_t::all_signals; sig != nullptr; sig = sig->link) {
+        sig->cover = 0;
+    }
+    process_cover.assign((process_info.size() + 31) / 32, 0);
+}
+
+//
+// Mark the current process as started, or as resumed when started before.
+// Kept out of line: when coverage is disabled, the scheduler only tests a flag.
+//
+void simulator_t::cover_process()
+{
+    uint64_t &word = process_cover[cur_proc->id / 32];
+    uint64_t run = uint64_t(COVER_RUN) << (cur_proc->id % 32 * 2);
+    word |= run | (word & run) << 1;
+}
+
+//
+// Add edges of the pending change to coverage of the signal.
+//
+void simulator_t::cover_signal(signal_base_t &sig)
+{
+    if (sig.cover != (COVER_RISE | COVER_FALL))
+        sig.cover |= sig.get_edges();
+}
+
+//
+// Keep coverage of a reclaimed process, as its id is reused.
+// Processes with the same name are merged, so memory does not grow
+// with the number of reclaimed processes.
+//
+void simulator_t::retire_coverage(const process_t &proc)
+{
+    uint64_t &word = process_cover[proc.id / 32];
+    unsigned shift = proc.id % 32 * 2;
+    retired_cover[proc.name] |= (word >> shift) & 3;
+    word &= ~(uint64_t(3) << shift);
+}
+
+//
+// Add coverage of this run to a given database.
+// Signals are reported by name, when they still exist.
+// Processes are reported by name: all instances of a name are merged.
+//
+void simulator_t::collect_coverage(coverage_t &cov) const
+{
+    if (!is_covering)
+        return;
+
+    for (signal_base_t *sig = signal_base_t::all_signals; sig != nullptr; sig = sig->link) {
+        cov.add(coverage_t::SIGNALS, sig->get_name(), sig->cover);
+    }
+    for (auto &[name, bits] : retired_cover) {
+        cov.add(coverage_t::PROCESSES, name.str(), bits);
+    }
+    for (auto &proc : all_processes) {
+        if (process_info[proc.id].coroutine)
+            cov.add(coverage_t::PROCESSES, proc.name.str(),
+                    (process_cover[proc.id / 32] >> (proc.id % 32 * 2)) & 3);
+    }
+}
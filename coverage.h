@@ -0,0 +1,79 @@
+//
+// Coverage database: toggles of signals and activations of processes.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//
+// Coverage, collected by a simulator and merged from many runs.
+// Items are signals and processes, identified by full names.
+// Each item has two bits, stored densely in order of adding:
+// COVER_RISE and COVER_FALL for a signal, COVER_RUN and COVER_WAKE for a process.
+// Runs are merged by OR of the bits of items with the same name.
+//
+class coverage_t {
+public:
+    // Kinds of items.
+    enum {
+        SIGNALS,
+        PROCESSES,
+    };
+
+private:
+    struct table_t {
+        std::vector<std::string> names;                  // Names of items, in order of index
+        std::unordered_map<std::string, uint32_t> index; // Index of item by name
+        std::vector<uint64_t> bits;                      // Two bits per item
+    };
+    table_t tables[2];
+
+public:
+    // Add an item, or merge bits to the item with the same name.
+    void add(int kind, const std::string &name, unsigned bits);
+
+    // Get number of items.
+    size_t size(int kind) const { return tables[kind].names.size(); }
+
+    // Get name and bits of an item by index.
+    const std::string &name(int kind, size_t i) const { return tables[kind].names[i]; }
+    unsigned get(int kind, size_t i) const
+    {
+        return (tables[kind].bits[i / 32] >> (i % 32 * 2)) & 3;
+    }
+
+    // Get number of items, which have all the given bits.
+    size_t count(int kind, unsigned mask) const;
+
+    // Merge coverage of another run.
+    void merge(const coverage_t &other);
+
+    // Write to a binary file.
+    bool save(const std::string &path) const;
+
+    // Read a binary file, and merge it.
+    bool load(const std::string &path);
+};
@@ -33,22 +33,6 @@ signal_t reset("reset");   // Active high, synchronous Reset
 signal_t enable("enable"); // Active high enable signal for counter
 signal_t count("count");   // 4-bit counter
 
-//
-// Clock generator.
-//
-co_void_t do_clock(simulator_t &sim)
-{
-    for (;;) {
-        sim.set(clk, 1);
-        //std::cout << '(' << sim.time() << ") Clock set" << std::endl;
-        co_await sim.delay(1);
-
-        sim.set(clk, 0);
-        //std::cout << '(' << sim.time() << ") Clock reset" << std::endl;
-        co_await sim.delay(1);
-    }
-}
-
 //
 // 4-bit up-counter with synchronous active high reset and
 // with active high enable signal.
@@ -56,11 +40,12 @@ co_void_t do_clock(simulator_t &sim)
 co_void_t do_counter(simulator_t &sim)
 {
     // Make the process sensitive to the clock.
-    sensitivity_t hook(sim, clk, POSEDGE);
+    // Edges are skipped while reset, enable and count stay unchanged.
+    clocked_t hook(sim, clk, POSEDGE, { &reset, &enable, &count });
 
     for (;;) {
         // Wait for positive edge of the clock.
-        co_await co_await_t{};
+        co_await sim.wait();
 
         // At every rising edge of clock we check if reset is active.
         // If active, we load the counter output with 4'b0000.
@@ -106,8 +91,10 @@ int main(int argc, char **argv)
 {
     simulator_t sim;
 
+    // Clock with period 2, high for 1 tick.
+    sim.make_clock(clk, 2, 1);
+
     // Create processes.
-    sim.make_process("clock", do_clock);
     sim.make_process("counter", do_counter);
     sim.make_process("master", master);
 
@@ -199,7 +199,7 @@ co_void_t do_b0(simulator_t &sim)
     sensitivity_t hook1(sim, a18);
     sensitivity_t hook2(sim, a27);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b0, !(a18.get() ^ a27.get()));
     }
 }
@@ -208,7 +208,7 @@ co_void_t do_b1(simulator_t &sim)
     sensitivity_t hook1(sim, a10);
     sensitivity_t hook2(sim, a9);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b1, (a10.get() | a9.get()));
     }
 }
@@ -217,7 +217,7 @@ co_void_t do_b2(simulator_t &sim)
     sensitivity_t hook1(sim, a42);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b2, a42.get() ^ a55.get());
     }
 }
@@ -226,7 +226,7 @@ co_void_t do_b3(simulator_t &sim)
     sensitivity_t hook1(sim, a13);
     sensitivity_t hook2(sim, a53);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b3, (a13.get() | a53.get()));
     }
 }
@@ -235,7 +235,7 @@ co_void_t do_b4(simulator_t &sim)
     sensitivity_t hook1(sim, a0);
     sensitivity_t hook2(sim, a14);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b4, !(a0.get() ^ a14.get()));
     }
 }
@@ -244,7 +244,7 @@ co_void_t do_b5(simulator_t &sim)
     sensitivity_t hook1(sim, a13);
     sensitivity_t hook2(sim, a57);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b5, (a13.get() | a57.get()));
     }
 }
@@ -253,7 +253,7 @@ co_void_t do_b6(simulator_t &sim)
     sensitivity_t hook1(sim, a63);
     sensitivity_t hook2(sim, a16);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b6, !(a63.get() ^ a16.get()));
     }
 }
@@ -262,7 +262,7 @@ co_void_t do_b7(simulator_t &sim)
     sensitivity_t hook1(sim, a41);
     sensitivity_t hook2(sim, a26);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b7, !(a41.get() ^ a26.get()));
     }
 }
@@ -271,7 +271,7 @@ co_void_t do_b8(simulator_t &sim)
     sensitivity_t hook1(sim, a31);
     sensitivity_t hook2(sim, a62);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b8, a31.get() ^ a62.get());
     }
 }
@@ -280,7 +280,7 @@ co_void_t do_b9(simulator_t &sim)
     sensitivity_t hook1(sim, a18);
     sensitivity_t hook2(sim, a54);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b9, !(a18.get() ^ a54.get()));
     }
 }
@@ -289,7 +289,7 @@ co_void_t do_b10(simulator_t &sim)
     sensitivity_t hook1(sim, a57);
     sensitivity_t hook2(sim, a5);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b10, a57.get() & a5.get());
     }
 }
@@ -298,7 +298,7 @@ co_void_t do_b11(simulator_t &sim)
     sensitivity_t hook1(sim, a5);
     sensitivity_t hook2(sim, a50);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b11, !(a5.get() ^ a50.get()));
     }
 }
@@ -307,7 +307,7 @@ co_void_t do_b12(simulator_t &sim)
     sensitivity_t hook1(sim, a28);
     sensitivity_t hook2(sim, a47);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b12, !(a28.get() ^ a47.get()));
     }
 }
@@ -316,7 +316,7 @@ co_void_t do_b13(simulator_t &sim)
     sensitivity_t hook1(sim, a55);
     sensitivity_t hook2(sim, a6);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b13, !(a55.get() | a6.get()));
     }
 }
@@ -325,7 +325,7 @@ co_void_t do_b14(simulator_t &sim)
     sensitivity_t hook1(sim, a24);
     sensitivity_t hook2(sim, a48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b14, !(a24.get() ^ a48.get()));
     }
 }
@@ -334,7 +334,7 @@ co_void_t do_b15(simulator_t &sim)
     sensitivity_t hook1(sim, a45);
     sensitivity_t hook2(sim, a28);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b15, !(a45.get() ^ a28.get()));
     }
 }
@@ -343,7 +343,7 @@ co_void_t do_b16(simulator_t &sim)
     sensitivity_t hook1(sim, a36);
     sensitivity_t hook2(sim, a26);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b16, !(a36.get() | a26.get()));
     }
 }
@@ -352,7 +352,7 @@ co_void_t do_b17(simulator_t &sim)
     sensitivity_t hook1(sim, a39);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b17, !(a39.get() & a55.get()));
     }
 }
@@ -361,7 +361,7 @@ co_void_t do_b18(simulator_t &sim)
     sensitivity_t hook1(sim, a26);
     sensitivity_t hook2(sim, a57);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b18, !(a26.get() & a57.get()));
     }
 }
@@ -370,7 +370,7 @@ co_void_t do_b19(simulator_t &sim)
     sensitivity_t hook1(sim, a39);
     sensitivity_t hook2(sim, a32);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b19, a39.get() ^ a32.get());
     }
 }
@@ -379,7 +379,7 @@ co_void_t do_b20(simulator_t &sim)
     sensitivity_t hook1(sim, a13);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b20, !(a13.get() & a55.get()));
     }
 }
@@ -388,7 +388,7 @@ co_void_t do_b21(simulator_t &sim)
     sensitivity_t hook1(sim, a51);
     sensitivity_t hook2(sim, a46);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b21, (a51.get() | a46.get()));
     }
 }
@@ -397,7 +397,7 @@ co_void_t do_b22(simulator_t &sim)
     sensitivity_t hook1(sim, a18);
     sensitivity_t hook2(sim, a51);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b22, a18.get() ^ a51.get());
     }
 }
@@ -406,7 +406,7 @@ co_void_t do_b23(simulator_t &sim)
     sensitivity_t hook1(sim, a17);
     sensitivity_t hook2(sim, a43);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b23, a17.get() ^ a43.get());
     }
 }
@@ -415,7 +415,7 @@ co_void_t do_b24(simulator_t &sim)
     sensitivity_t hook1(sim, a16);
     sensitivity_t hook2(sim, a2);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b24, (a16.get() | a2.get()));
     }
 }
@@ -424,7 +424,7 @@ co_void_t do_b25(simulator_t &sim)
     sensitivity_t hook1(sim, a30);
     sensitivity_t hook2(sim, a32);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b25, !(a30.get() | a32.get()));
     }
 }
@@ -433,7 +433,7 @@ co_void_t do_b26(simulator_t &sim)
     sensitivity_t hook1(sim, a44);
     sensitivity_t hook2(sim, a62);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b26, a44.get() & a62.get());
     }
 }
@@ -442,7 +442,7 @@ co_void_t do_b27(simulator_t &sim)
     sensitivity_t hook1(sim, a52);
     sensitivity_t hook2(sim, a25);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b27, !(a52.get() ^ a25.get()));
     }
 }
@@ -451,7 +451,7 @@ co_void_t do_b28(simulator_t &sim)
     sensitivity_t hook1(sim, a36);
     sensitivity_t hook2(sim, a61);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b28, !(a36.get() | a61.get()));
     }
 }
@@ -460,7 +460,7 @@ co_void_t do_b29(simulator_t &sim)
     sensitivity_t hook1(sim, a21);
     sensitivity_t hook2(sim, a48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b29, !(a21.get() | a48.get()));
     }
 }
@@ -469,7 +469,7 @@ co_void_t do_b30(simulator_t &sim)
     sensitivity_t hook1(sim, a47);
     sensitivity_t hook2(sim, a56);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b30, !(a47.get() & a56.get()));
     }
 }
@@ -478,7 +478,7 @@ co_void_t do_b31(simulator_t &sim)
     sensitivity_t hook1(sim, a56);
     sensitivity_t hook2(sim, a17);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b31, !(a56.get() & a17.get()));
     }
 }
@@ -487,7 +487,7 @@ co_void_t do_b32(simulator_t &sim)
     sensitivity_t hook1(sim, a18);
     sensitivity_t hook2(sim, a4);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b32, !(a18.get() ^ a4.get()));
     }
 }
@@ -496,7 +496,7 @@ co_void_t do_b33(simulator_t &sim)
     sensitivity_t hook1(sim, a56);
     sensitivity_t hook2(sim, a52);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b33, !(a56.get() & a52.get()));
     }
 }
@@ -505,7 +505,7 @@ co_void_t do_b34(simulator_t &sim)
     sensitivity_t hook1(sim, a48);
     sensitivity_t hook2(sim, a28);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b34, !(a48.get() ^ a28.get()));
     }
 }
@@ -514,7 +514,7 @@ co_void_t do_b35(simulator_t &sim)
     sensitivity_t hook1(sim, a40);
     sensitivity_t hook2(sim, a49);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b35, a40.get() & a49.get());
     }
 }
@@ -523,7 +523,7 @@ co_void_t do_b36(simulator_t &sim)
     sensitivity_t hook1(sim, a40);
     sensitivity_t hook2(sim, a5);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b36, (a40.get() | a5.get()));
     }
 }
@@ -532,7 +532,7 @@ co_void_t do_b37(simulator_t &sim)
     sensitivity_t hook1(sim, a7);
     sensitivity_t hook2(sim, a11);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b37, !(a7.get() & a11.get()));
     }
 }
@@ -541,7 +541,7 @@ co_void_t do_b38(simulator_t &sim)
     sensitivity_t hook1(sim, a33);
     sensitivity_t hook2(sim, a28);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b38, a33.get() ^ a28.get());
     }
 }
@@ -550,7 +550,7 @@ co_void_t do_b39(simulator_t &sim)
     sensitivity_t hook1(sim, a0);
     sensitivity_t hook2(sim, a9);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b39, a0.get() & a9.get());
     }
 }
@@ -559,7 +559,7 @@ co_void_t do_b40(simulator_t &sim)
     sensitivity_t hook1(sim, a30);
     sensitivity_t hook2(sim, a24);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b40, (a30.get() | a24.get()));
     }
 }
@@ -568,7 +568,7 @@ co_void_t do_b41(simulator_t &sim)
     sensitivity_t hook1(sim, a38);
     sensitivity_t hook2(sim, a5);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b41, a38.get() & a5.get());
     }
 }
@@ -577,7 +577,7 @@ co_void_t do_b42(simulator_t &sim)
     sensitivity_t hook1(sim, a10);
     sensitivity_t hook2(sim, a41);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b42, (a10.get() | a41.get()));
     }
 }
@@ -586,7 +586,7 @@ co_void_t do_b43(simulator_t &sim)
     sensitivity_t hook1(sim, a24);
     sensitivity_t hook2(sim, a39);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b43, a24.get() & a39.get());
     }
 }
@@ -595,7 +595,7 @@ co_void_t do_b44(simulator_t &sim)
     sensitivity_t hook1(sim, a41);
     sensitivity_t hook2(sim, a54);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b44, a41.get() ^ a54.get());
     }
 }
@@ -604,7 +604,7 @@ co_void_t do_b45(simulator_t &sim)
     sensitivity_t hook1(sim, a29);
     sensitivity_t hook2(sim, a32);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b45, !(a29.get() & a32.get()));
     }
 }
@@ -613,7 +613,7 @@ co_void_t do_b46(simulator_t &sim)
     sensitivity_t hook1(sim, a18);
     sensitivity_t hook2(sim, a54);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b46, a18.get() & a54.get());
     }
 }
@@ -622,7 +622,7 @@ co_void_t do_b47(simulator_t &sim)
     sensitivity_t hook1(sim, a45);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b47, !(a45.get() ^ a55.get()));
     }
 }
@@ -631,7 +631,7 @@ co_void_t do_b48(simulator_t &sim)
     sensitivity_t hook1(sim, a15);
     sensitivity_t hook2(sim, a16);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b48, !(a15.get() ^ a16.get()));
     }
 }
@@ -640,7 +640,7 @@ co_void_t do_b49(simulator_t &sim)
     sensitivity_t hook1(sim, a13);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b49, !(a13.get() & a55.get()));
     }
 }
@@ -649,7 +649,7 @@ co_void_t do_b50(simulator_t &sim)
     sensitivity_t hook1(sim, a28);
     sensitivity_t hook2(sim, a6);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b50, !(a28.get() & a6.get()));
     }
 }
@@ -658,7 +658,7 @@ co_void_t do_b51(simulator_t &sim)
     sensitivity_t hook1(sim, a5);
     sensitivity_t hook2(sim, a37);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b51, !(a5.get() & a37.get()));
     }
 }
@@ -667,7 +667,7 @@ co_void_t do_b52(simulator_t &sim)
     sensitivity_t hook1(sim, a50);
     sensitivity_t hook2(sim, a42);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b52, a50.get() & a42.get());
     }
 }
@@ -676,7 +676,7 @@ co_void_t do_b53(simulator_t &sim)
     sensitivity_t hook1(sim, a57);
     sensitivity_t hook2(sim, a5);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b53, !(a57.get() ^ a5.get()));
     }
 }
@@ -685,7 +685,7 @@ co_void_t do_b54(simulator_t &sim)
     sensitivity_t hook1(sim, a35);
     sensitivity_t hook2(sim, a10);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b54, !(a35.get() | a10.get()));
     }
 }
@@ -694,7 +694,7 @@ co_void_t do_b55(simulator_t &sim)
     sensitivity_t hook1(sim, a49);
     sensitivity_t hook2(sim, a38);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b55, a49.get() ^ a38.get());
     }
 }
@@ -703,7 +703,7 @@ co_void_t do_b56(simulator_t &sim)
     sensitivity_t hook1(sim, a46);
     sensitivity_t hook2(sim, a48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b56, !(a46.get() | a48.get()));
     }
 }
@@ -712,7 +712,7 @@ co_void_t do_b57(simulator_t &sim)
     sensitivity_t hook1(sim, a56);
     sensitivity_t hook2(sim, a33);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b57, !(a56.get() | a33.get()));
     }
 }
@@ -721,7 +721,7 @@ co_void_t do_b58(simulator_t &sim)
     sensitivity_t hook1(sim, a55);
     sensitivity_t hook2(sim, a55);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b58, !(a55.get() & a55.get()));
     }
 }
@@ -730,7 +730,7 @@ co_void_t do_b59(simulator_t &sim)
     sensitivity_t hook1(sim, a40);
     sensitivity_t hook2(sim, a22);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b59, a40.get() & a22.get());
     }
 }
@@ -739,7 +739,7 @@ co_void_t do_b60(simulator_t &sim)
     sensitivity_t hook1(sim, a14);
     sensitivity_t hook2(sim, a61);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b60, !(a14.get() ^ a61.get()));
     }
 }
@@ -748,7 +748,7 @@ co_void_t do_b61(simulator_t &sim)
     sensitivity_t hook1(sim, a28);
     sensitivity_t hook2(sim, a53);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b61, !(a28.get() ^ a53.get()));
     }
 }
@@ -757,7 +757,7 @@ co_void_t do_b62(simulator_t &sim)
     sensitivity_t hook1(sim, a49);
     sensitivity_t hook2(sim, a23);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b62, (a49.get() | a23.get()));
     }
 }
@@ -766,7 +766,7 @@ co_void_t do_b63(simulator_t &sim)
     sensitivity_t hook1(sim, a4);
     sensitivity_t hook2(sim, a11);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b63, !(a4.get() ^ a11.get()));
     }
 }
@@ -775,7 +775,7 @@ co_void_t do_c0(simulator_t &sim)
     sensitivity_t hook1(sim, b20);
     sensitivity_t hook2(sim, b3);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c0, !(b20.get() & b3.get()));
     }
 }
@@ -784,7 +784,7 @@ co_void_t do_c1(simulator_t &sim)
     sensitivity_t hook1(sim, b58);
     sensitivity_t hook2(sim, b63);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c1, !(b58.get() & b63.get()));
     }
 }
@@ -793,7 +793,7 @@ co_void_t do_c2(simulator_t &sim)
     sensitivity_t hook1(sim, b23);
     sensitivity_t hook2(sim, b22);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c2, (b23.get() | b22.get()));
     }
 }
@@ -802,7 +802,7 @@ co_void_t do_c3(simulator_t &sim)
     sensitivity_t hook1(sim, b50);
     sensitivity_t hook2(sim, b25);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c3, !(b50.get() | b25.get()));
     }
 }
@@ -811,7 +811,7 @@ co_void_t do_c4(simulator_t &sim)
     sensitivity_t hook1(sim, b39);
     sensitivity_t hook2(sim, b3);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c4, b39.get() ^ b3.get());
     }
 }
@@ -820,7 +820,7 @@ co_void_t do_c5(simulator_t &sim)
     sensitivity_t hook1(sim, b57);
     sensitivity_t hook2(sim, b22);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c5, !(b57.get() & b22.get()));
     }
 }
@@ -829,7 +829,7 @@ co_void_t do_c6(simulator_t &sim)
     sensitivity_t hook1(sim, b44);
     sensitivity_t hook2(sim, b9);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c6, b44.get() ^ b9.get());
     }
 }
@@ -838,7 +838,7 @@ co_void_t do_c7(simulator_t &sim)
     sensitivity_t hook1(sim, b49);
     sensitivity_t hook2(sim, b61);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c7, !(b49.get() | b61.get()));
     }
 }
@@ -847,7 +847,7 @@ co_void_t do_c8(simulator_t &sim)
     sensitivity_t hook1(sim, b50);
     sensitivity_t hook2(sim, b9);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c8, !(b50.get() | b9.get()));
     }
 }
@@ -856,7 +856,7 @@ co_void_t do_c9(simulator_t &sim)
     sensitivity_t hook1(sim, b10);
     sensitivity_t hook2(sim, b49);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c9, b10.get() ^ b49.get());
     }
 }
@@ -865,7 +865,7 @@ co_void_t do_c10(simulator_t &sim)
     sensitivity_t hook1(sim, b63);
     sensitivity_t hook2(sim, b20);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c10, b63.get() & b20.get());
     }
 }
@@ -874,7 +874,7 @@ co_void_t do_c11(simulator_t &sim)
     sensitivity_t hook1(sim, b22);
     sensitivity_t hook2(sim, b60);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c11, (b22.get() | b60.get()));
     }
 }
@@ -883,7 +883,7 @@ co_void_t do_c12(simulator_t &sim)
     sensitivity_t hook1(sim, b37);
     sensitivity_t hook2(sim, b9);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c12, b37.get() ^ b9.get());
     }
 }
@@ -892,7 +892,7 @@ co_void_t do_c13(simulator_t &sim)
     sensitivity_t hook1(sim, b43);
     sensitivity_t hook2(sim, b54);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c13, !(b43.get() ^ b54.get()));
     }
 }
@@ -901,7 +901,7 @@ co_void_t do_c14(simulator_t &sim)
     sensitivity_t hook1(sim, b62);
     sensitivity_t hook2(sim, b43);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c14, !(b62.get() ^ b43.get()));
     }
 }
@@ -910,7 +910,7 @@ co_void_t do_c15(simulator_t &sim)
     sensitivity_t hook1(sim, b63);
     sensitivity_t hook2(sim, b47);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c15, !(b63.get() & b47.get()));
     }
 }
@@ -919,7 +919,7 @@ co_void_t do_c16(simulator_t &sim)
     sensitivity_t hook1(sim, b57);
     sensitivity_t hook2(sim, b44);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c16, b57.get() ^ b44.get());
     }
 }
@@ -928,7 +928,7 @@ co_void_t do_c17(simulator_t &sim)
     sensitivity_t hook1(sim, b32);
     sensitivity_t hook2(sim, b11);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c17, !(b32.get() & b11.get()));
     }
 }
@@ -937,7 +937,7 @@ co_void_t do_c18(simulator_t &sim)
     sensitivity_t hook1(sim, b57);
     sensitivity_t hook2(sim, b53);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c18, b57.get() ^ b53.get());
     }
 }
@@ -946,7 +946,7 @@ co_void_t do_c19(simulator_t &sim)
     sensitivity_t hook1(sim, b24);
     sensitivity_t hook2(sim, b51);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c19, b24.get() ^ b51.get());
     }
 }
@@ -955,7 +955,7 @@ co_void_t do_c20(simulator_t &sim)
     sensitivity_t hook1(sim, b53);
     sensitivity_t hook2(sim, b48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c20, (b53.get() | b48.get()));
     }
 }
@@ -964,7 +964,7 @@ co_void_t do_c21(simulator_t &sim)
     sensitivity_t hook1(sim, b12);
     sensitivity_t hook2(sim, b27);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c21, !(b12.get() ^ b27.get()));
     }
 }
@@ -973,7 +973,7 @@ co_void_t do_c22(simulator_t &sim)
     sensitivity_t hook1(sim, b32);
     sensitivity_t hook2(sim, b4);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c22, b32.get() ^ b4.get());
     }
 }
@@ -982,7 +982,7 @@ co_void_t do_c23(simulator_t &sim)
     sensitivity_t hook1(sim, b37);
     sensitivity_t hook2(sim, b2);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c23, !(b37.get() ^ b2.get()));
     }
 }
@@ -991,7 +991,7 @@ co_void_t do_c24(simulator_t &sim)
     sensitivity_t hook1(sim, b34);
     sensitivity_t hook2(sim, b4);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c24, (b34.get() | b4.get()));
     }
 }
@@ -1000,7 +1000,7 @@ co_void_t do_c25(simulator_t &sim)
     sensitivity_t hook1(sim, b9);
     sensitivity_t hook2(sim, b24);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c25, (b9.get() | b24.get()));
     }
 }
@@ -1009,7 +1009,7 @@ co_void_t do_c26(simulator_t &sim)
     sensitivity_t hook1(sim, b60);
     sensitivity_t hook2(sim, b13);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c26, (b60.get() | b13.get()));
     }
 }
@@ -1018,7 +1018,7 @@ co_void_t do_c27(simulator_t &sim)
     sensitivity_t hook1(sim, b22);
     sensitivity_t hook2(sim, b39);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c27, !(b22.get() & b39.get()));
     }
 }
@@ -1027,7 +1027,7 @@ co_void_t do_c28(simulator_t &sim)
     sensitivity_t hook1(sim, b60);
     sensitivity_t hook2(sim, b39);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c28, !(b60.get() & b39.get()));
     }
 }
@@ -1036,7 +1036,7 @@ co_void_t do_c29(simulator_t &sim)
     sensitivity_t hook1(sim, b32);
     sensitivity_t hook2(sim, b14);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c29, b32.get() ^ b14.get());
     }
 }
@@ -1045,7 +1045,7 @@ co_void_t do_c30(simulator_t &sim)
     sensitivity_t hook1(sim, b57);
     sensitivity_t hook2(sim, b49);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c30, !(b57.get() | b49.get()));
     }
 }
@@ -1054,7 +1054,7 @@ co_void_t do_c31(simulator_t &sim)
     sensitivity_t hook1(sim, b61);
     sensitivity_t hook2(sim, b44);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c31, b61.get() & b44.get());
     }
 }
@@ -1063,7 +1063,7 @@ co_void_t do_c32(simulator_t &sim)
     sensitivity_t hook1(sim, b19);
     sensitivity_t hook2(sim, b20);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c32, b19.get() ^ b20.get());
     }
 }
@@ -1072,7 +1072,7 @@ co_void_t do_c33(simulator_t &sim)
     sensitivity_t hook1(sim, b45);
     sensitivity_t hook2(sim, b24);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c33, !(b45.get() ^ b24.get()));
     }
 }
@@ -1081,7 +1081,7 @@ co_void_t do_c34(simulator_t &sim)
     sensitivity_t hook1(sim, b31);
     sensitivity_t hook2(sim, b35);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c34, !(b31.get() | b35.get()));
     }
 }
@@ -1090,7 +1090,7 @@ co_void_t do_c35(simulator_t &sim)
     sensitivity_t hook1(sim, b23);
     sensitivity_t hook2(sim, b63);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c35, b23.get() ^ b63.get());
     }
 }
@@ -1099,7 +1099,7 @@ co_void_t do_c36(simulator_t &sim)
     sensitivity_t hook1(sim, b5);
     sensitivity_t hook2(sim, b48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c36, (b5.get() | b48.get()));
     }
 }
@@ -1108,7 +1108,7 @@ co_void_t do_c37(simulator_t &sim)
     sensitivity_t hook1(sim, b20);
     sensitivity_t hook2(sim, b26);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c37, b20.get() ^ b26.get());
     }
 }
@@ -1117,7 +1117,7 @@ co_void_t do_c38(simulator_t &sim)
     sensitivity_t hook1(sim, b30);
     sensitivity_t hook2(sim, b21);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c38, b30.get() ^ b21.get());
     }
 }
@@ -1126,7 +1126,7 @@ co_void_t do_c39(simulator_t &sim)
     sensitivity_t hook1(sim, b62);
     sensitivity_t hook2(sim, b54);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c39, b62.get() & b54.get());
     }
 }
@@ -1135,7 +1135,7 @@ co_void_t do_c40(simulator_t &sim)
     sensitivity_t hook1(sim, b13);
     sensitivity_t hook2(sim, b36);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c40, b13.get() & b36.get());
     }
 }
@@ -1144,7 +1144,7 @@ co_void_t do_c41(simulator_t &sim)
     sensitivity_t hook1(sim, b37);
     sensitivity_t hook2(sim, b22);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c41, !(b37.get() & b22.get()));
     }
 }
@@ -1153,7 +1153,7 @@ co_void_t do_c42(simulator_t &sim)
     sensitivity_t hook1(sim, b26);
     sensitivity_t hook2(sim, b25);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c42, !(b26.get() | b25.get()));
     }
 }
@@ -1162,7 +1162,7 @@ co_void_t do_c43(simulator_t &sim)
     sensitivity_t hook1(sim, b8);
     sensitivity_t hook2(sim, b18);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c43, b8.get() & b18.get());
     }
 }
@@ -1171,7 +1171,7 @@ co_void_t do_c44(simulator_t &sim)
     sensitivity_t hook1(sim, b47);
     sensitivity_t hook2(sim, b61);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c44, !(b47.get() | b61.get()));
     }
 }
@@ -1180,7 +1180,7 @@ co_void_t do_c45(simulator_t &sim)
     sensitivity_t hook1(sim, b40);
     sensitivity_t hook2(sim, b15);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c45, !(b40.get() | b15.get()));
     }
 }
@@ -1189,7 +1189,7 @@ co_void_t do_c46(simulator_t &sim)
     sensitivity_t hook1(sim, b11);
     sensitivity_t hook2(sim, b39);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c46, !(b11.get() & b39.get()));
     }
 }
@@ -1198,7 +1198,7 @@ co_void_t do_c47(simulator_t &sim)
     sensitivity_t hook1(sim, b17);
     sensitivity_t hook2(sim, b61);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c47, !(b17.get() ^ b61.get()));
     }
 }
@@ -1207,7 +1207,7 @@ co_void_t do_c48(simulator_t &sim)
     sensitivity_t hook1(sim, b15);
     sensitivity_t hook2(sim, b26);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c48, !(b15.get() | b26.get()));
     }
 }
@@ -1216,7 +1216,7 @@ co_void_t do_c49(simulator_t &sim)
     sensitivity_t hook1(sim, b45);
     sensitivity_t hook2(sim, b48);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c49, !(b45.get() & b48.get()));
     }
 }
@@ -1225,7 +1225,7 @@ co_void_t do_c50(simulator_t &sim)
     sensitivity_t hook1(sim, b15);
     sensitivity_t hook2(sim, b44);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c50, b15.get() & b44.get());
     }
 }
@@ -1234,7 +1234,7 @@ co_void_t do_c51(simulator_t &sim)
     sensitivity_t hook1(sim, b38);
     sensitivity_t hook2(sim, b44);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c51, !(b38.get() & b44.get()));
     }
 }
@@ -1243,7 +1243,7 @@ co_void_t do_c52(simulator_t &sim)
     sensitivity_t hook1(sim, b54);
     sensitivity_t hook2(sim, b13);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c52, !(b54.get() | b13.get()));
     }
 }
@@ -1252,7 +1252,7 @@ co_void_t do_c53(simulator_t &sim)
     sensitivity_t hook1(sim, b37);
     sensitivity_t hook2(sim, b28);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c53, b37.get() ^ b28.get());
     }
 }
@@ -1261,7 +1261,7 @@ co_void_t do_c54(simulator_t &sim)
     sensitivity_t hook1(sim, b61);
     sensitivity_t hook2(sim, b33);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c54, b61.get() & b33.get());
     }
 }
@@ -1270,7 +1270,7 @@ co_void_t do_c55(simulator_t &sim)
     sensitivity_t hook1(sim, b39);
     sensitivity_t hook2(sim, b17);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c55, !(b39.get() ^ b17.get()));
     }
 }
@@ -1279,7 +1279,7 @@ co_void_t do_c56(simulator_t &sim)
     sensitivity_t hook1(sim, b20);
     sensitivity_t hook2(sim, b37);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c56, (b20.get() | b37.get()));
     }
 }
@@ -1288,7 +1288,7 @@ co_void_t do_c57(simulator_t &sim)
     sensitivity_t hook1(sim, b47);
     sensitivity_t hook2(sim, b3);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c57, !(b47.get() | b3.get()));
     }
 }
@@ -1297,7 +1297,7 @@ co_void_t do_c58(simulator_t &sim)
     sensitivity_t hook1(sim, b11);
     sensitivity_t hook2(sim, b25);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c58, !(b11.get() ^ b25.get()));
     }
 }
@@ -1306,7 +1306,7 @@ co_void_t do_c59(simulator_t &sim)
     sensitivity_t hook1(sim, b30);
     sensitivity_t hook2(sim, b50);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c59, b30.get() ^ b50.get());
     }
 }
@@ -1315,7 +1315,7 @@ co_void_t do_c60(simulator_t &sim)
     sensitivity_t hook1(sim, b55);
     sensitivity_t hook2(sim, b47);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c60, !(b55.get() & b47.get()));
     }
 }
@@ -1324,7 +1324,7 @@ co_void_t do_c61(simulator_t &sim)
     sensitivity_t hook1(sim, b34);
     sensitivity_t hook2(sim, b30);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c61, !(b34.get() & b30.get()));
     }
 }
@@ -1333,7 +1333,7 @@ co_void_t do_c62(simulator_t &sim)
     sensitivity_t hook1(sim, b56);
     sensitivity_t hook2(sim, b42);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c62, b56.get() ^ b42.get());
     }
 }
@@ -1342,7 +1342,7 @@ co_void_t do_c63(simulator_t &sim)
     sensitivity_t hook1(sim, b20);
     sensitivity_t hook2(sim, b0);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c63, !(b20.get() | b0.get()));
     }
 }
@@ -0,0 +1,93 @@
+//
+// Demo: a tri-state bus with two drivers, and a wide checksum register.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <iostream>
+
+#include "simulator.h"
+#include "bitvec.h"
+#include "logic.h"
+#include "resolved.h"
+
+//
+// Signals.
+//
+resolved_signal_t<8> bus("bus");                 // Shared data bus
+typed_signal_t<bitvec<128>> checksum("checksum"); // Sum of all words, seen on the bus
+
+//
+// Device: drives a word to the bus, then releases it.
+//
+co_void_t device(simulator_t &sim, uint64_t word, uint64_t start)
+{
+    driver_t<8> drv(sim, bus);
+
+    co_await sim.delay(start);
+    sim.set(drv, logic_t<8>(word));
+    co_await sim.delay(2);
+    sim.set(drv, logic_t<8>::z());
+}
+
+co_void_t device_a(simulator_t &sim)
+{
+    return device(sim, 0x5a, 2);
+}
+
+co_void_t device_b(simulator_t &sim)
+{
+    // Starts while device A still drives the bus: a conflict.
+    return device(sim, 0x3c, 3);
+}
+
+//
+// Monitor: print the bus, and sum the known words in a wide register.
+//
+co_void_t monitor(simulator_t &sim)
+{
+    for (;;) {
+        co_await sim.wait(bus);
+        logic_t<8> value = bus.get();
+        std::cout << '(' << sim.time() << ") Bus " << value;
+        if (value.is_known()) {
+            bitvec<128> word(value.to_uint64());
+            sim.set(checksum, checksum.get() + (word << 64) + word);
+        } else {
+            std::cout << " - not a valid word";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    simulator_t sim;
+
+    // Create processes.
+    sim.make_process("device_a", device_a);
+    sim.make_process("device_b", device_b);
+    sim.make_process("monitor", monitor);
+
+    // Run simulation.
+    sim.run();
+    std::cout << '(' << sim.time() << ") Checksum " << checksum.get().to_string() << std::endl;
+    return 0;
+}
@@ -0,0 +1,101 @@
+//
+// Demo: spawn processes, join them, interrupt a join.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <iostream>
+
+#include "simulator.h"
+
+//
+// Handles of processes, for the watchdog.
+//
+process_handle_t slow, master_handle, quitter_handle;
+
+//
+// Worker: busy for a given number of clock ticks.
+//
+co_void_t worker(simulator_t &sim, const char *name, uint64_t num_clocks)
+{
+    std::cout << '(' << sim.time() << ") Worker " << name << " started" << std::endl;
+    co_await sim.delay(num_clocks);
+    std::cout << '(' << sim.time() << ") Worker " << name << " done" << std::endl;
+}
+
+//
+// Process which gives up waiting for the slow worker, and quits.
+//
+co_void_t quitter(simulator_t &sim)
+{
+    co_await sim.join(slow);
+    std::cout << '(' << sim.time() << ") Quitter stops waiting" << std::endl;
+}
+
+//
+// Watchdog: interrupt the processes, waiting for the slow worker.
+//
+co_void_t watchdog(simulator_t &sim)
+{
+    co_await sim.delay(5);
+    std::cout << '(' << sim.time() << ") Watchdog interrupts joiners" << std::endl;
+    sim.interrupt(master_handle);
+    sim.interrupt(quitter_handle);
+}
+
+//
+// Master process: start workers and wait for them.
+//
+co_void_t master(simulator_t &sim)
+{
+    master_handle = sim.get_handle(sim.current_process());
+    std::cout << '(' << sim.time() << ") Started" << std::endl;
+
+    slow = sim.spawn("slow", worker(sim, "slow", 10));
+    process_handle_t fast = sim.spawn("fast", worker(sim, "fast", 3));
+    quitter_handle = sim.spawn("quitter", quitter(sim));
+    sim.spawn("watchdog", watchdog(sim));
+
+    // Interrupted by the watchdog.
+    co_await sim.join(slow);
+    std::cout << '(' << sim.time() << ") Join interrupted, slow is "
+              << (sim.is_alive(slow) ? "alive" : "done") << std::endl;
+
+    // Fast worker has finished already: ready at once.
+    co_await sim.join(fast);
+    std::cout << '(' << sim.time() << ") Joined fast" << std::endl;
+
+    // Wait again, till the end.
+    co_await sim.join(slow);
+    std::cout << '(' << sim.time() << ") Joined slow" << std::endl;
+    sim.finish();
+}
+
+int main(int argc, char **argv)
+{
+    simulator_t sim;
+
+    // Create processes.
+    sim.make_process("master", master);
+
+    // Run simulation.
+    sim.run();
+    return 0;
+}
@@ -0,0 +1,278 @@
+//
+// Four-state logic vector: 0, 1, X and Z.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#include "bitvec.h"
+#include "simulator.h"
+
+//
+// Vector of N four-state bits, stored in two bit planes,
+// like aval/bval in Verilog PLI:
+//
+//      value unknown
+//        0     0       - 0
+//        1     0       - 1
+//        0     1       - Z
+//        1     1       - X
+//
+// Logic operations are evaluated on whole words, in a few instructions
+// per 64 bits. Z on input of a logic operation is treated as X.
+// Unused bits of the top words are always zero.
+//
+template <unsigned N>
+class logic_t {
+    static_assert(N > 0, "logic vector cannot be empty");
+
+public:
+    static constexpr unsigned num_words = (N + 63) / 64; // Size of each plane in 64-bit words
+
+private:
+    uint64_t value[num_words]{};   // Value plane
+    uint64_t unknown[num_words]{}; // Plane of X and Z bits
+
+    // Mask of used bits in a word.
+    static constexpr uint64_t mask(unsigned i)
+    {
+        if (N % 64 != 0 && i == num_words - 1)
+            return (uint64_t(1) << (N % 64)) - 1;
+        return ~uint64_t(0);
+    }
+
+    // Fill all bits with given planes.
+    constexpr void fill(uint64_t v, uint64_t u)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            value[i] = v & mask(i);
+            unknown[i] = u & mask(i);
+        }
+    }
+
+public:
+    // All zeros.
+    constexpr logic_t() = default;
+
+    // Known value from integer, truncated to N bits.
+    constexpr logic_t(uint64_t v) { value[0] = v & mask(0); }
+
+    // Known value from bit vector.
+    constexpr logic_t(const bitvec<N> &v)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            value[i] = v.word(i);
+        }
+    }
+
+    // All bits unknown.
+    static constexpr logic_t x()
+    {
+        logic_t r;
+        r.fill(~uint64_t(0), ~uint64_t(0));
+        return r;
+    }
+
+    // All bits in high impedance.
+    static constexpr logic_t z()
+    {
+        logic_t r;
+        r.fill(0, ~uint64_t(0));
+        return r;
+    }
+
+    // Get width in bits.
+    static constexpr unsigned width() { return N; }
+
+    // Check whether all bits are 0 or 1.
+    constexpr bool is_known() const
+    {
+        uint64_t acc = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+            acc |= unknown[i];
+        }
+        return acc == 0;
+    }
+
+    // Get known bits as a bit vector: X and Z are read as 0.
+    constexpr bitvec<N> to_bitvec() const
+    {
+        bitvec<N> r;
+        for (unsigned i = 0; i < num_words; i++) {
+            r.set_word(i, value[i] & ~unknown[i]);
+        }
+        return r;
+    }
+
+    // Get words of the bit planes.
+    constexpr uint64_t value_word(unsigned i) const { return value[i]; }
+    constexpr uint64_t unknown_word(unsigned i) const { return unknown[i]; }
+
+    // Get low 64 bits: X and Z are read as 0.
+    constexpr uint64_t to_uint64() const { return value[0] & ~unknown[0]; }
+
+    // Get a bit as character: '0', '1', 'x' or 'z'.
+    constexpr char bit(unsigned i) const
+    {
+        unsigned v = (value[i / 64] >> (i % 64)) & 1;
+        unsigned u = (unknown[i / 64] >> (i % 64)) & 1;
+        return "01zx"[v | u << 1];
+    }
+
+    // Set a bit from character: '0', '1', 'x' or 'z'.
+    constexpr void set_bit(unsigned i, char c)
+    {
+        uint64_t m = uint64_t(1) << (i % 64);
+        bool v = (c == '1' || c == 'x' || c == 'X');
+        bool u = (c != '0' && c != '1');
+        value[i / 64] = v ? (value[i / 64] | m) : (value[i / 64] & ~m);
+        unknown[i / 64] = u ? (unknown[i / 64] | m) : (unknown[i / 64] & ~m);
+    }
+
+    //
+    // Logic operations, per Verilog tables.
+    // A known 0 dominates AND, and a known 1 dominates OR;
+    // otherwise any X or Z on input gives X.
+    //
+    constexpr logic_t &operator&=(const logic_t &b)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t zero = (~value[i] & ~unknown[i]) | (~b.value[i] & ~b.unknown[i]);
+            uint64_t one = value[i] & ~unknown[i] & b.value[i] & ~b.unknown[i];
+            unknown[i] = ~(zero | one) & mask(i);
+            value[i] = one | unknown[i];
+        }
+        return *this;
+    }
+
+    constexpr logic_t &operator|=(const logic_t &b)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t one = (value[i] & ~unknown[i]) | (b.value[i] & ~b.unknown[i]);
+            uint64_t zero = ~value[i] & ~unknown[i] & ~b.value[i] & ~b.unknown[i];
+            unknown[i] = ~(zero | one) & mask(i);
+            value[i] = one | unknown[i];
+        }
+        return *this;
+    }
+
+    constexpr logic_t &operator^=(const logic_t &b)
+    {
+        for (unsigned i = 0; i < num_words; i++) {
+            unknown[i] |= b.unknown[i];
+            value[i] = (value[i] ^ b.value[i]) | unknown[i];
+        }
+        return *this;
+    }
+
+    constexpr logic_t operator~() const
+    {
+        logic_t r;
+        for (unsigned i = 0; i < num_words; i++) {
+            r.unknown[i] = unknown[i];
+            r.value[i] = (~value[i] & mask(i)) | unknown[i];
+        }
+        return r;
+    }
+
+    friend constexpr logic_t operator&(const logic_t &a, const logic_t &b)
+    {
+        return logic_t(a) &= b;
+    }
+    friend constexpr logic_t operator|(const logic_t &a, const logic_t &b)
+    {
+        return logic_t(a) |= b;
+    }
+    friend constexpr logic_t operator^(const logic_t &a, const logic_t &b)
+    {
+        return logic_t(a) ^= b;
+    }
+
+    //
+    // Case equality, like === in Verilog: X and Z must match exactly.
+    // Used by signals to detect a change.
+    //
+    friend bool operator==(const logic_t &a, const logic_t &b)
+    {
+        return std::memcmp(a.value, b.value, sizeof(a.value)) == 0 &&
+               std::memcmp(a.unknown, b.unknown, sizeof(a.unknown)) == 0;
+    }
+
+    //
+    // Logical equality, like == in Verilog: X when the result
+    // depends on unknown bits.
+    //
+    constexpr logic_t<1> eq(const logic_t &b) const
+    {
+        uint64_t differ = 0, unknown_bits = 0;
+        for (unsigned i = 0; i < num_words; i++) {
+            uint64_t u = unknown[i] | b.unknown[i];
+            differ |= (value[i] ^ b.value[i]) & ~u;
+            unknown_bits |= u;
+        }
+        if (differ != 0)
+            return logic_t<1>(0);
+        if (unknown_bits != 0)
+            return logic_t<1>::x();
+        return logic_t<1>(1);
+    }
+
+    //
+    // Print as binary, most significant bit first.
+    //
+    std::string to_string() const
+    {
+        std::string s;
+        for (unsigned i = N; i-- > 0;) {
+            s += bit(i);
+        }
+        return s;
+    }
+};
+
+//
+// Edges of a change of the least significant bit, per Verilog:
+// 0 to 1, X or Z is a positive edge, and so is X or Z to 1;
+// 1 to 0, X or Z is a negative edge, and so is X or Z to 0.
+//
+template <unsigned N>
+int signal_edges(const logic_t<N> &from, const logic_t<N> &to)
+{
+    char a = from.bit(0), b = to.bit(0);
+    if (a == b)
+        return 0;
+    if (a == '0' || b == '1')
+        return POSEDGE;
+    if (a == '1' || b == '0')
+        return NEGEDGE;
+    return 0;
+}
+
+template <unsigned N>
+std::ostream &operator<<(std::ostream &out, const logic_t<N> &v)
+{
+    return out << v.to_string();
+}
@@ -0,0 +1,162 @@
+//
+// Hierarchical names of processes and signals, interned in a path tree.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include "names.h"
+
+#include <unordered_map>
+#include <vector>
+
+//
+// Node of the path tree.
+//
+struct name_node_t {
+    uint32_t parent; // Parent node
+    uint32_t leaf;   // Interned leaf name
+    uint32_t index;  // Index, or NO_INDEX
+};
+
+//
+// Path tree, with interned leaf names.
+// Created on first use, as names can be built by static constructors of signals.
+//
+struct name_table_t {
+    std::vector<name_node_t> nodes{ { 0, 0, name_t::NO_INDEX } }; // Node 0 is the root
+    std::vector<std::string> leaves{ "" };                       // Interned strings
+    std::unordered_map<std::string, uint32_t> leaf_ids{ { "", 0 } };
+    std::unordered_map<uint64_t, uint32_t> node_ids; // Nodes without index, by parent and leaf
+
+    // Intern a string.
+    uint32_t intern(const std::string &s)
+    {
+        auto [it, inserted] = leaf_ids.try_emplace(s, leaves.size());
+        if (inserted)
+            leaves.push_back(s);
+        return it->second;
+    }
+
+    // Find or create a node without index.
+    uint32_t child(uint32_t parent, uint32_t leaf)
+    {
+        uint64_t key = (uint64_t(parent) << 32) | leaf;
+        auto [it, inserted] = node_ids.try_emplace(key, nodes.size());
+        if (inserted)
+            nodes.push_back({ parent, leaf, name_t::NO_INDEX });
+        return it->second;
+    }
+};
+
+static name_table_t &table()
+{
+    static name_table_t t;
+    return t;
+}
+
+//
+// Name from a path, with components separated by dots.
+//
+name_t::name_t(const std::string &path)
+{
+    if (path.empty())
+        return;
+
+    auto &t = table();
+    size_t pos = 0;
+    for (;;) {
+        size_t dot = path.find('.', pos);
+        id = t.child(id, t.intern(path.substr(pos, dot - pos)));
+        if (dot == std::string::npos)
+            break;
+        pos = dot + 1;
+    }
+}
+
+//
+// Child of a given parent, with optional index.
+// Indexed nodes are not looked up: they are usually created in bulk.
+//
+name_t::name_t(name_t parent, const std::string &leaf, uint32_t index)
+{
+    auto &t = table();
+    uint32_t l = t.intern(leaf);
+    if (index == NO_INDEX) {
+        id = t.child(parent.id, l);
+    } else {
+        id = t.nodes.size();
+        t.nodes.push_back({ parent.id, l, index });
+    }
+}
+
+//
+// Allocate a range of indexed children at once.
+//
+name_t name_t::make_array(name_t parent, const std::string &leaf, uint32_t count)
+{
+    auto &t = table();
+    uint32_t l = t.intern(leaf);
+    uint32_t first = t.nodes.size();
+
+    t.nodes.reserve(first + count);
+    for (uint32_t i = 0; i < count; i++) {
+        t.nodes.push_back({ parent.id, l, i });
+    }
+    return name_t(first);
+}
+
+//
+// Get parent node.
+//
+name_t name_t::parent() const
+{
+    return name_t(table().nodes[id].parent);
+}
+
+//
+// Get index, or NO_INDEX.
+//
+uint32_t name_t::index() const
+{
+    return table().nodes[id].index;
+}
+
+//
+// Build the full path, from the root down.
+//
+std::string name_t::str() const
+{
+    auto &t = table();
+    if (id == 0)
+        return {};
+
+    std::string s = name_t(t.nodes[id].parent).str();
+    if (!s.empty())
+        s += '.';
+
+    const name_node_t &node = t.nodes[id];
+    s += t.leaves[node.leaf];
+    if (node.index != NO_INDEX) {
+        s += '[';
+        s += std::to_string(node.index);
+        s += ']';
+    }
+    return s;
+}
@@ -0,0 +1,83 @@
+//
+// Hierarchical names of processes and signals, interned in a path tree.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+//
+// Hierarchical name, like "top.cpu.alu" or "top.core[3]".
+// Names are nodes of a path tree, shared by the whole program:
+// each node keeps a parent, an interned leaf name and an optional index.
+// A name takes 4 bytes, and the full string is built only when needed,
+// for snapshots or logging. Nodes without index are unique,
+// so that common prefixes of names are stored only once.
+//
+class name_t {
+private:
+    uint32_t id{ 0 }; // Node of the path tree, 0 for the root
+
+    explicit name_t(uint32_t i) : id(i) {}
+
+public:
+    static constexpr uint32_t NO_INDEX = UINT32_MAX; // Node has no index
+
+    // Root of the tree: empty name.
+    name_t() = default;
+
+    // Name from a path, with components separated by dots.
+    name_t(const std::string &path);
+    name_t(const char *path) : name_t(std::string(path)) {}
+
+    // Child of a given parent, with optional index: parent.leaf[index].
+    name_t(name_t parent, const std::string &leaf, uint32_t index = NO_INDEX);
+
+    // Allocate a range of children with indices 0...count-1: parent.leaf[i].
+    // Return the first one; the rest follow with consecutive ids.
+    static name_t make_array(name_t parent, const std::string &leaf, uint32_t count);
+
+    // Get i-th element of a range, allocated by make_array().
+    name_t operator[](uint32_t i) const { return name_t(id + i); }
+
+    // Get parent node.
+    name_t parent() const;
+
+    // Get index, or NO_INDEX.
+    uint32_t index() const;
+
+    // Get the full path.
+    std::string str() const;
+
+    // Names are equal when they refer to the same node.
+    friend bool operator==(name_t a, name_t b) { return a.id == b.id; }
+
+    // Order of nodes, for use as a key of std::map.
+    friend bool operator<(name_t a, name_t b) { return a.id < b.id; }
+};
+
+inline std::ostream &operator<<(std::ostream &out, name_t name)
+{
+    return out << name.str();
+}
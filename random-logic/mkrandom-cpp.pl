@@ -39,7 +39,7 @@ for ($i = 0; $i < $gates; ++$i) {
     sensitivity_t hook1(sim, a$x);
     sensitivity_t hook2(sim, a$y);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(b$i, $op);
     }
 }
@@ -64,7 +64,7 @@ for ($i = 0; $i < $gates; ++$i) {
     sensitivity_t hook1(sim, b$x);
     sensitivity_t hook2(sim, b$y);
     for (;;) {
-        co_await co_await_t{};
+        co_await sim.wait();
         sim.set(c$i, $op);
     }
 }
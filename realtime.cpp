@@ -0,0 +1,124 @@
+//
+// Real-time mode: pacing of simulated time by the wall clock.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <time.h>
+
+#include <algorithm>
+
+#include "simulator.h"
+
+//
+// Sleep until this much time is left to the deadline, then spin.
+// Wakeup of the sleep is late by tens of microseconds on a typical system.
+//
+static const uint64_t spin_ns = 100000;
+
+//
+// Longest sleep without looking into the inbox.
+// Events from other threads are received with this latency at most.
+//
+static const uint64_t slice_ns = 100000;
+
+//
+// Get monotonic time in nanoseconds.
+//
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+//
+// Sleep until the given monotonic time.
+// A relative sleep is used, as clock_nanosleep() is not available everywhere.
+// When interrupted by a signal, return earlier: the caller checks the time again.
+//
+static void sleep_until(uint64_t ns)
+{
+    uint64_t now = monotonic_ns();
+    if (now >= ns)
+        return;
+
+    struct timespec ts;
+    ts.tv_sec = (ns - now) / 1000000000;
+    ts.tv_nsec = (ns - now) % 1000000000;
+    nanosleep(&ts, nullptr);
+}
+
+//
+// Enable or disable real-time mode.
+// The current simulated time is mapped to the current wall-clock time.
+//
+void simulator_t::set_realtime(uint64_t ns_per_tick, int policy)
+{
+    pacing.ns_per_tick = ns_per_tick;
+    pacing.policy = policy;
+    pacing.base_ns = monotonic_ns();
+    pacing.base_ticks = time_ticks;
+}
+
+//
+// Wait for the wall-clock deadline of a given tick.
+// Return false as soon as an event from another thread has arrived:
+// it may be due before the tick, and must not wait for the deadline.
+// When the deadline has passed, update the lag statistics,
+// and with PACING_RESYNC, map the tick to the current wall-clock time.
+//
+bool simulator_t::pace(uint64_t ticks)
+{
+    uint64_t deadline = pacing.base_ns + (ticks - pacing.base_ticks) * pacing.ns_per_tick;
+    uint64_t now = monotonic_ns();
+
+    if (now < deadline) {
+        // Sleep in slices, and spin for the rest, watching the inbox.
+        while (now + spin_ns < deadline) {
+            sleep_until(std::min(now + slice_ns, deadline - spin_ns));
+            if (inbox.load(std::memory_order_relaxed) != nullptr)
+                return false;
+            now = monotonic_ns();
+        }
+        do {
+            if (inbox.load(std::memory_order_relaxed) != nullptr)
+                return false;
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+            now = monotonic_ns();
+        } while (now < deadline);
+    } else {
+        pacing_stats.num_late++;
+        if (pacing.policy == PACING_RESYNC) {
+            pacing.base_ns = now;
+            pacing.base_ticks = ticks;
+        }
+    }
+
+    // Lag is the lateness of the deadline, or the overshoot of the spin.
+    uint64_t lag = now - deadline;
+    pacing_stats.num_steps++;
+    pacing_stats.total_lag_ns += lag;
+    if (lag > pacing_stats.max_lag_ns)
+        pacing_stats.max_lag_ns = lag;
+    return true;
+}
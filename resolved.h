@@ -0,0 +1,147 @@
+//
+// Resolved signals with multiple drivers: tri-state buses, wired-AND and wired-OR.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#pragma once
+
+#include "logic.h"
+
+// Resolution functions.
+enum {
+    RESOLVE_WIRE, // Tri-state bus: Z when not driven, X on conflict
+    RESOLVE_WAND, // Wired-AND: 0 wins
+    RESOLVE_WOR,  // Wired-OR: 1 wins
+};
+
+//
+// Signal with many drivers. Each driver keeps its own contribution,
+// and the value of the signal is resolved from all of them.
+// For every bit, the signal counts drivers of 0, 1 and X:
+// when a driver changes, only the changed bits are updated,
+// in O(1) time regardless of the number of drivers.
+// Drivers in Z state are not counted.
+//
+template <unsigned N>
+class resolved_signal_t : public typed_signal_t<logic_t<N>> {
+    friend class simulator_t;
+
+private:
+    int kind;                               // Resolution function
+    uint32_t count[N][3]{};                 // Number of drivers per bit: 0, 1, X
+    logic_t<N> resolved{ logic_t<N>::z() }; // Resolved value from all drivers
+
+    // Resolve one bit from counts of drivers.
+    char resolve(unsigned i) const
+    {
+        uint32_t zeros = count[i][0], ones = count[i][1], unknowns = count[i][2];
+
+        switch (kind) {
+        case RESOLVE_WAND:
+            return zeros ? '0' : unknowns ? 'x' : ones ? '1' : 'z';
+        case RESOLVE_WOR:
+            return ones ? '1' : unknowns ? 'x' : zeros ? '0' : 'z';
+        default:
+            if (unknowns || (zeros && ones))
+                return 'x';
+            return zeros ? '0' : ones ? '1' : 'z';
+        }
+    }
+
+    // Update counts for a bit, changed from one state to another.
+    // States are encoded as value | unknown << 1: 0, 1, Z or X.
+    // Z is not counted, and X is counted in slot 2.
+    void update(unsigned i, unsigned from, unsigned to)
+    {
+        if (from != 2)
+            count[i][from == 3 ? 2 : from]--;
+        if (to != 2)
+            count[i][to == 3 ? 2 : to]++;
+        resolved.set_bit(i, resolve(i));
+    }
+
+public:
+    // Allocate a signal with given name and resolution function.
+    // Not driven, it has Z value.
+    explicit resolved_signal_t(name_t n, int k = RESOLVE_WIRE)
+        : typed_signal_t<logic_t<N>>(n, logic_t<N>::z()), kind(k)
+    {
+    }
+};
+
+//
+// Driver of a resolved signal.
+// Initially it drives Z, and releases the signal when destroyed.
+// The destructor updates the signal through the simulator,
+// so both must outlive the driver. Drivers local to processes are fine:
+// the simulator destroys its processes before its own fields.
+//
+template <unsigned N>
+class driver_t {
+    friend class simulator_t;
+
+private:
+    simulator_t &sim;                    // Simulator, to update the signal
+    resolved_signal_t<N> &signal;        // Signal to drive
+    logic_t<N> value{ logic_t<N>::z() }; // Contribution of this driver
+
+public:
+    // Constructor: connect a new driver to the signal.
+    driver_t(simulator_t &s, resolved_signal_t<N> &sig) : sim(s), signal(sig) {}
+
+    // Forbid the copy constructor.
+    driver_t(const driver_t &) = delete;
+
+    // Destructor: release the signal.
+    ~driver_t() { sim.set(*this, logic_t<N>::z()); }
+
+    // Get contribution of this driver.
+    const logic_t<N> &get() const { return value; }
+};
+
+//
+// Update contribution of a driver to a resolved signal.
+// Only bits which differ from the previous contribution are resolved again.
+//
+template <unsigned N>
+void simulator_t::set(driver_t<N> &driver, const logic_t<N> &v)
+{
+    resolved_signal_t<N> &sig = driver.signal;
+
+    for (unsigned w = 0; w < logic_t<N>::num_words; w++) {
+        uint64_t old_value = driver.value.value_word(w);
+        uint64_t old_unknown = driver.value.unknown_word(w);
+        uint64_t new_value = v.value_word(w);
+        uint64_t new_unknown = v.unknown_word(w);
+        uint64_t changed = (old_value ^ new_value) | (old_unknown ^ new_unknown);
+
+        while (changed != 0) {
+            unsigned b = __builtin_ctzll(changed);
+            changed &= changed - 1;
+
+            unsigned from = ((old_value >> b) & 1) | ((old_unknown >> b) & 1) << 1;
+            unsigned to = ((new_value >> b) & 1) | ((new_unknown >> b) & 1) << 1;
+            sig.update(w * 64 + b, from, to);
+        }
+    }
+    driver.value = v;
+    set(sig, sig.resolved);
+}
@@ -23,6 +23,7 @@
 //
 #include "simulator.h"
 
+#include <algorithm>
 #include <iostream>
 
 //
@@ -30,99 +31,601 @@
 //
 simulator_t::~simulator_t()
 {
-    for (auto &proc : all_processes) {
-        // std::cout << "destroy " << proc.name << " handle: " << proc.continuation.address() <<
-        // std::endl;
-        proc.continuation.destroy();
+    while (!checkpoints.empty()) {
+        drop_checkpoint(0);
+    }
+    // Free pending actions, including delayed assignments of this simulator
+    // and events not yet received from the inbox.
+    drop_events();
+    drain_inbox();
+    drop_events();
+    for (auto &info : process_info) {
+        // std::cout << "destroy handle: " << info.coroutine.address() << std::endl;
+        if (info.coroutine)
+            info.coroutine.destroy();
     }
 }
 
 //
 // Create a process with given name and given top level routine.
 //
-void simulator_t::make_process(const std::string &name, co_void_t (*func)(simulator_t &sim))
+void simulator_t::make_process(name_t name, co_void_t (*func)(simulator_t &sim))
 {
-    // Allocate new structure for the process.
-    all_processes.push_back(process_t(name));
+    // Lazy-start the coroutine.
+    spawn(name, func(*this));
+}
+
+//
+// Start a new process from a coroutine.
+// Ids of finished processes are reused.
+//
+process_handle_t simulator_t::spawn(name_t name, co_void_t co)
+{
+    // Allocate new structure for the process, in the arena.
+    process_t *proc;
+    if (free_ids.empty()) {
+        proc = &all_processes.emplace_back(all_processes.size(), name);
+        process_info.push_back({ nullptr, 0, UINT32_MAX, UINT32_MAX, UINT32_MAX });
+        if (is_covering && proc->id % 32 == 0)
+            process_cover.push_back(0);
+    } else {
+        proc = &all_processes[free_ids.back()];
+        free_ids.pop_back();
+        proc->name = name;
+        proc->trigger = nullptr;
+    }
+    auto &info = process_info[proc->id];
 
-    // Get reference to the new process descriptor.
-    auto &proc = all_processes.back();
+    // Store the continuation.
+    co.set_continuation(&proc->continuation);
+    co.set_simulator(this);
+    info.coroutine = co;
+    proc->continuation = co;
+    // std::cout << "process " << proc->name << " handle: " << handle.address() << std::endl;
 
-    // Lazy-start the coroutine and store the continuation.
-    proc.continuation = func(*this);
-    // std::cout << "process " << proc.name << " handle: " << handle.address() << std::endl;
+    // During simulation, run the process in the current delta cycle.
+    if (started)
+        activate(*proc);
+    return { proc->id, info.generation };
 }
 
 //
-// Run the simulation.
+// Current process is done, normally or by exception.
+// Wake up processes which wait for it, and leave the frame
+// to be destroyed at the end of delta cycle.
+// On failure with FAULT_STOP policy, stop the simulation at the end of delta cycle.
+// Return continuation of the next process.
 //
-void simulator_t::run()
+std::coroutine_handle<> simulator_t::exit_process(const std::exception_ptr &exception)
+{
+    auto &info = process_info[cur_proc->id];
+
+    if (exception) {
+        // Process has failed.
+        faults.push_back({ cur_proc->name, time_ticks, exception });
+        if (fault_policy == FAULT_STOP) {
+            fault = exception;
+            finished = true;
+        }
+    }
+
+    // Handles of this process are not valid anymore.
+    info.generation++;
+
+    while (info.joiners != UINT32_MAX) {
+        process_t &joiner = all_processes[info.joiners];
+        auto &joiner_info = process_info[joiner.id];
+        info.joiners = joiner_info.next_joiner;
+        joiner_info.next_joiner = UINT32_MAX;
+        if (joiner_info.joining != cur_proc->id)
+            continue;
+        joiner_info.joining = UINT32_MAX;
+
+        // A joiner, already activated otherwise (like by interrupt()), is only removed.
+        if (joiner.pprev == nullptr && joiner.continuation) {
+            activate(joiner);
+            joiner.trigger = nullptr;
+        }
+    }
+    exited.push_back(cur_proc->id);
+
+    // Frame stays at the final suspend point: never resume it again.
+    cur_proc->continuation = nullptr;
+    return next_process();
+}
+
+//
+// Destroy frames of finished processes, and free their ids for reuse.
+// Frames are returned to the pool.
+//
+void simulator_t::reclaim()
+{
+    for (uint32_t id : exited) {
+        auto &info = process_info[id];
+        if (is_covering)
+            retire_coverage(all_processes[id]);
+        info.coroutine.destroy();
+        info.coroutine = nullptr;
+        free_ids.push_back(id);
+    }
+    exited.clear();
+}
+
+//
+// Process has been woken up during join(), but not by the target:
+// remove it from the list of joiners of the target.
+//
+void simulator_t::leave_joiners(uint32_t id)
+{
+    auto &info = process_info[id];
+    uint32_t *ptr = &process_info[info.joining].joiners;
+    while (*ptr != id)
+        ptr = &process_info[*ptr].next_joiner;
+    *ptr = info.next_joiner;
+    info.next_joiner = UINT32_MAX;
+    info.joining = UINT32_MAX;
+}
+
+//
+// Wait until the process is finished.
+//
+join_t simulator_t::join(process_handle_t h)
 {
+    return join_t(*this, h);
+}
+
+//
+// Create processes for a number of instances of a module.
+// Names are allocated in one range, without building any strings.
+//
+void simulator_t::make_processes(name_t parent, const std::string &leaf, uint32_t count,
+                                 co_void_t (*func)(simulator_t &sim))
+{
+    name_t names = name_t::make_array(parent, leaf, count);
+    for (uint32_t i = 0; i < count; i++) {
+        make_process(names[i], func);
+    }
+}
+
+//
+// Connect a clock signal to a timer with given parameters,
+// or create a new timer. The first positive edge is after the phase delay.
+// A clock joining an existing timer gets its current level.
+//
+bool simulator_t::add_clock(signal_base_t &clk, clock_drive_t drive, uint64_t period,
+                            uint64_t high, uint64_t phase)
+{
+    if (high == 0 || high >= period)
+        return false;
+
+    uint64_t origin = (time_ticks + phase) % period;
+    for (auto &timer : clock_timers) {
+        if (timer.period == period && timer.high == high && timer.origin == origin) {
+            timer.outputs.push_back({ &clk, drive });
+            drive(*this, clk, timer.level);
+            return true;
+        }
+    }
+
+    clock_timers.emplace_back(period, high, origin);
+    auto &timer = clock_timers.back();
+    timer.outputs.push_back({ &clk, drive });
+    drive(*this, clk, false);
+    schedule(timer, phase);
+    return true;
+}
+
+//
+// Clock edge is due: set new level on all clocks of the timer.
+// Activation of sensitive processes is done when signals are committed.
+//
+void clock_timer_t::fire(simulator_t &sim)
+{
+    level = !level;
+    for (auto &out : outputs) {
+        out.drive(sim, *out.signal, level);
+    }
+    sim.schedule(*this, level ? high : period - high);
+}
+
+//
+// Put all processes to the event queue.
+// It's done only once, on the first run.
+//
+void simulator_t::start()
+{
+    if (started)
+        return;
+    started = true;
+
     // Add all processes to the event queue.
     for (auto &proc : all_processes) {
-        proc.next = event_queue;
-        event_queue = &proc;
+        activate(proc);
+    }
+}
+
+//
+// Put the process to the head of the event queue,
+// to run in the current delta cycle.
+//
+inline void simulator_t::activate(process_t &proc)
+{
+    proc.next = event_queue;
+    proc.pprev = &event_queue;
+    if (event_queue != nullptr)
+        event_queue->pprev = &proc.next;
+    event_queue = &proc;
+}
+
+//
+// Put the event to the queue, after a given number of clock ticks.
+// Keep the queue sorted.
+//
+void simulator_t::schedule(event_t &ev, uint64_t num_clocks)
+{
+    event_t **que_ptr = &event_queue;
+    event_t *p;
+    while ((p = *que_ptr) != nullptr) {
+        if (p->delay > num_clocks) {
+            p->delay -= num_clocks;
+            break;
+        }
+
+        if (p->delay > 0)
+            num_clocks -= p->delay;
+        que_ptr = &p->next;
     }
+    ev.delay = num_clocks;
+    ev.next = p;
+    ev.pprev = que_ptr;
+    if (p != nullptr)
+        p->pprev = &ev.next;
+    *que_ptr = &ev;
+}
 
+//
+// Remove the event from the queue, in O(1).
+// Delays are relative, so the next event inherits the delay.
+//
+void simulator_t::unschedule(event_t &ev)
+{
+    event_t *next = ev.next;
+
+    *ev.pprev = next;
+    if (next != nullptr) {
+        next->pprev = ev.pprev;
+        next->delay += ev.delay;
+    }
+    ev.next = nullptr;
+    ev.pprev = nullptr;
+    ev.delay = 0;
+}
+
+//
+// Remove all events from the queue.
+// Actions, owned by the queue, are freed.
+//
+void simulator_t::drop_events()
+{
     while (event_queue != nullptr) {
-        if (event_queue->delay != 0) {
+        event_t *ev = event_queue;
+        event_queue = ev->next;
+        ev->next = nullptr;
+        ev->pprev = nullptr;
+        ev->delay = 0;
+        if (ev != ev->process)
+            static_cast<action_t *>(ev)->drop();
+    }
+}
+
+//
+// Take all events, sent by other threads, and put them to the event queue.
+// The inbox is a stack, so it's reversed to keep the order of arrival.
+//
+void simulator_t::drain_inbox()
+{
+    injected_t *list = inbox.exchange(nullptr, std::memory_order_acquire);
+    injected_t *fifo = nullptr;
+    while (list != nullptr) {
+        injected_t *next = list->next_injected;
+        list->next_injected = fifo;
+        fifo = list;
+        list = next;
+    }
+    while (fifo != nullptr) {
+        injected_t *ev = fifo;
+        fifo = ev->next_injected;
+        schedule(*ev, (ev->when > time_ticks) ? ev->when - time_ticks : 0);
+    }
+}
+
+//
+// Send an event from any thread.
+// Lock-free push to the inbox: only one atomic operation per event.
+//
+void simulator_t::inject(uint64_t when, std::function<void(simulator_t &)> func)
+{
+    injected_t *ev = new injected_t(when, std::move(func));
+
+    injected_t *head = inbox.load(std::memory_order_relaxed);
+    do {
+        ev->next_injected = head;
+    } while (!inbox.compare_exchange_weak(head, ev, std::memory_order_release,
+                                          std::memory_order_relaxed));
+}
+
+//
+// Check whether a change of the signal would activate the hook.
+//
+inline bool simulator_t::can_activate(const sensitivity_t &hook, const signal_base_t &sig)
+{
+    const process_t &proc = hook.process;
+    if (proc.pprev != nullptr) {
+        // Process is already in the queue.
+        // Only a timed wait can be interrupted, and only once.
+        if (!hook.is_timed || proc.trigger != nullptr)
+            return false;
+    }
+
+    // Signal change should match the edge flag.
+    return hook.edge == 0 || !(hook.edge & ~sig.get_edges());
+}
+
+//
+// Check whether the hook is a clocked process with unchanged inputs:
+// it has nothing to do.
+//
+inline bool simulator_t::is_idle(const sensitivity_t &hook)
+{
+    return hook.is_idle && !static_cast<const clocked_t &>(hook).has_pending_inputs();
+}
+
+//
+// Setup a new value of the signal.
+// Most signals are plain words: skip the virtual call for them.
+//
+inline void simulator_t::commit_value(signal_base_t &sig)
+{
+    if (sig.is_word)
+        static_cast<signal_t &>(sig).signal_t::commit();
+    else
+        sig.commit();
+}
+
+//
+// Delta cycle finished.
+// Schedule processes for active signals, and setup new values of the signals.
+//
+void simulator_t::commit_signals()
+{
+    while (active_signals != nullptr) {
+        signal_base_t *sig = active_signals;
+        active_signals = sig->next;
+        sig->next = nullptr;
+        sig->is_active = false;
+
+        if (!sig->is_changed) {
+            // Signal has returned to the old value: a glitch.
+            // Skip all processes, sensitive to this signal, and count those
+            // which would have been activated.
+            num_glitches++;
+            for (sensitivity_t *hook = sig->hook_list; hook != nullptr; hook = hook->next) {
+                if (can_activate(*hook, *sig) && !is_idle(*hook))
+                    num_suppressed++;
+            }
+            commit_value(*sig);
+            continue;
+        }
+
+        // Clocked processes with this input are not idle anymore.
+        for (clocked_input_t *in = sig->input_list; in != nullptr; in = in->next) {
+            in->hook.is_idle = false;
+        }
+        if (is_covering)
+            cover_signal(*sig);
+
+        // Handle all processes, sensitive to this signal.
+        for (sensitivity_t *hook = sig->hook_list; hook != nullptr; hook = hook->next) {
+            if (!can_activate(*hook, *sig))
+                continue;
+
+            if (is_idle(*hook)) {
+                num_idle++;
+                continue;
+            }
+
+            // Cancel the timeout.
+            process_t &proc = hook->process;
+            if (proc.pprev != nullptr)
+                unschedule(proc);
+
+            // Put the process to queue of pending events.
+            activate(proc);
+            proc.trigger = hook;
+            hook->is_idle = hook->is_clocked;
+
+            // std::cout << '(' << time_ticks << ") Process '"
+            //          << proc.name << "' activated" << std::endl;
+        }
+
+        // Setup a new signal value.
+        commit_value(*sig);
+    }
+    // std::cout << '(' << time_ticks << ") ---" << std::endl;
+}
+
+//
+// Run the simulation until the time limit is reached.
+// When one_delta is set, stop after one delta cycle.
+// Return false when no events are left, or the simulation is finished.
+//
+bool simulator_t::simulate(uint64_t limit, bool one_delta)
+{
+    start();
+
+    bool resumed = false;
+    for (;;) {
+        if (event_queue == nullptr || event_queue->delay != 0) {
             // Delta cycle finished.
-            // Schedule processes for active signals.
-            while (active_signals != nullptr) {
-                sensitivity_t *hook = active_signals->hook_list;
-                signal_t *next = active_signals->next;
-
-                // Handle all processes, sensitive to this signal.
-                for (; hook != nullptr; hook = hook->next) {
-                    if (hook->process.next == nullptr) {
-                        // Signal change should matches the edge flag.
-                        if ((hook->edge & POSEDGE) &&
-                            (active_signals->value != 0 || active_signals->new_value == 0))
-                            continue;
-                        if ((hook->edge & NEGEDGE) &&
-                            (active_signals->value == 0 || active_signals->new_value != 0))
-                            continue;
-
-                        // Put the process to queue of pending events.
-                        hook->process.next = event_queue;
-                        event_queue = &hook->process;
-
-                        // std::cout << '(' << time_ticks << ") Process '"
-                        //          << hook->process.name << "' activated" << std::endl;
-                    }
+            cur_proc = nullptr;
+            if (!exited.empty())
+                reclaim();
+            if (finished) {
+                if (fault) {
+                    // Process has failed: pass the exception to the caller.
+                    // The simulation can be continued.
+                    finished = false;
+                    std::rethrow_exception(std::exchange(fault, nullptr));
+                }
+                return false;
+            }
+            if (++delta_count > oscillation_start && track_oscillation())
+                return false;
+            commit_signals();
+
+            // Time step finished: receive events from other threads.
+            if ((event_queue == nullptr || event_queue->delay != 0) &&
+                inbox.load(std::memory_order_relaxed) != nullptr)
+                drain_inbox();
+
+            if (one_delta && resumed)
+                return event_queue != nullptr;
+            if (event_queue == nullptr)
+                return false;
+
+            if (event_queue->delay != 0) {
+                if (pacing.ns_per_tick != 0) {
+                    // Wait for the wall clock. Events from other threads,
+                    // received meanwhile, may be due earlier.
+                    while (!pace(time_ticks + std::min(event_queue->delay, limit - time_ticks)))
+                        drain_inbox();
+                }
+                if (event_queue->delay > limit - time_ticks) {
+                    // Stop at the time limit.
+                    event_queue->delay -= limit - time_ticks;
+                    time_ticks = limit;
+                    delta_count = 0;
+                    return true;
                 }
 
-                // Setup a new signal value.
-                active_signals->value = active_signals->new_value;
-                active_signals->next = nullptr;
-                active_signals->is_active = false;
-                active_signals = next;
+                // Advance time.
+                time_ticks += event_queue->delay;
+                event_queue->delay = 0;
+                delta_count = 0;
             }
-            // std::cout << '(' << time_ticks << ") ---" << std::endl;
         }
 
-        // Select next process from the queue.
-        cur_proc = event_queue;
-        event_queue = event_queue->next;
-        cur_proc->next = nullptr;
-        if (cur_proc->delay != 0) {
-            // Advance time.
-            time_ticks += cur_proc->delay;
+        // Select next event from the queue.
+        event_t *ev = event_queue;
+        event_queue = ev->next;
+        if (event_queue != nullptr)
+            event_queue->pprev = &event_queue;
+        ev->pprev = nullptr;
+
+        if (ev != ev->process) {
+            // Action is due: alarm, delayed assignment, clock edge or external event.
+            static_cast<action_t *>(ev)->fire(*this);
+            continue;
         }
+        cur_proc = ev->process;
+        if (is_covering)
+            cover_process();
 
-        // Resume the process.
+        // Resume the process: it may switch to next processes by itself.
         // std::cout << '(' << time_ticks << ") Resume process '" << cur_proc->name << '\'' <<
         // std::endl;
+        chain_length = 0;
         cur_proc->continuation.resume();
+        resumed = true;
+    }
+}
+
+//
+// Too many delta cycles at one time step: probably a combinational loop.
+// Count changes of signals in the last delta cycles before the limit.
+// At the limit, finish the simulation, and report the signals
+// which have toggled most. Return true when finished.
+//
+bool simulator_t::track_oscillation()
+{
+    if (loop_time != time_ticks) {
+        // New time step: forget changes from the previous one.
+        loop_toggles.clear();
+        loop_time = time_ticks;
+    }
+    for (signal_base_t *sig = active_signals; sig != nullptr; sig = sig->next) {
+        if (sig->is_changed)
+            loop_toggles[sig]++;
+    }
+    if (delta_count < delta_limit)
+        return false;
+
+    // Sort by number of changes, then by name.
+    std::vector<std::pair<signal_base_t *, uint64_t>> list(loop_toggles.begin(),
+                                                           loop_toggles.end());
+    std::sort(list.begin(), list.end(), [](const auto &a, const auto &b) {
+        if (a.second != b.second)
+            return a.second > b.second;
+        return a.first->get_name() < b.first->get_name();
+    });
+    if (list.size() > 10)
+        list.resize(10);
+
+    oscillation.time = time_ticks;
+    oscillation.num_deltas = delta_count;
+    oscillation.signals.clear();
+    for (auto &item : list) {
+        oscillation.signals.emplace_back(item.first->get_path(), item.second);
     }
+    loop_toggles.clear();
+    finish();
+    return true;
 }
 
 //
-// Finish the simulation.
+// Run the simulation until no events are left, or finish() is called.
+// Can be continued after run_until() or step_delta().
+//
+void simulator_t::run()
+{
+    simulate(UINT64_MAX, false);
+}
+
+//
+// Run the simulation until the given time.
+// Return false when no events are left, or the simulation is finished.
+//
+bool simulator_t::run_until(uint64_t limit)
+{
+    return simulate(std::max(limit, time_ticks), false);
+}
+
+//
+// Run the simulation for a given number of clock ticks.
+// Return false when no events are left, or the simulation is finished.
+//
+bool simulator_t::run_for(uint64_t num_clocks)
+{
+    return simulate(time_ticks + num_clocks, false);
+}
+
+//
+// Run one delta cycle: processes ready at the current time
+// (or at the time of the next event), and update of signals.
+// Return false when no events are left, or the simulation is finished.
+//
+bool simulator_t::step_delta()
+{
+    return simulate(UINT64_MAX, true);
+}
+
+//
+// Finish the simulation, permanently.
 //
 void simulator_t::finish()
 {
-    event_queue = nullptr;
+    drop_events();
+    finished = true;
 }
 
 //
@@ -134,44 +637,143 @@ void simulator_t::finish()
 co_await_t simulator_t::delay(uint64_t num_clocks)
 {
     // Put the current process to queue of pending events.
-    // Keep the queue sorted.
-    process_t **que_ptr = &event_queue;
-    process_t *p;
-    while ((p = *que_ptr) != nullptr) {
-        if (p->delay > num_clocks) {
-            p->delay -= num_clocks;
-            break;
-        }
+    schedule(*cur_proc, num_clocks);
 
-        if (p->delay > 0)
-            num_clocks -= p->delay;
-        que_ptr = &p->next;
+    // On return, suspend the currect coroutine and switch to the next process.
+    return { this };
+}
+
+//
+// Activate the process in the current delta cycle.
+// Pending delay or timeout of the process is cancelled.
+//
+void simulator_t::interrupt(process_t &proc)
+{
+    // Finished process cannot be resumed.
+    if (!proc.continuation)
+        return;
+
+    if (proc.pprev != nullptr)
+        unschedule(proc);
+    activate(proc);
+    proc.trigger = nullptr;
+}
+
+//
+// Activate the process, unless it has finished.
+//
+void simulator_t::interrupt(process_handle_t h)
+{
+    if (is_alive(h))
+        interrupt(all_processes[h.id]);
+}
+
+//
+// Start the alarm, or restart it when pending.
+//
+void alarm_t::start(uint64_t num_clocks)
+{
+    cancel();
+    sim.schedule(*this, num_clocks);
+}
+
+//
+// Cancel the alarm, when pending.
+//
+void alarm_t::cancel()
+{
+    if (is_pending())
+        sim.unschedule(*this);
+}
+
+//
+// Cancel delayed assignments to the signal, due at or after a given time.
+// The waveform is sorted by time, so the tail of the list is removed.
+//
+void simulator_t::cancel_transactions(signal_base_t &signal, uint64_t from)
+{
+    transaction_base_t **ptr = &signal.waveform;
+    while (*ptr != nullptr && (*ptr)->when < from) {
+        ptr = &(*ptr)->next_pending;
+    }
+
+    transaction_base_t *t = *ptr;
+    *ptr = nullptr;
+    while (t != nullptr) {
+        transaction_base_t *next = t->next_pending;
+        if (t->is_pending())
+            unschedule(*t);
+        delete t;
+        t = next;
     }
-    cur_proc->delay = num_clocks;
-    cur_proc->next = p;
-    *que_ptr = cur_proc;
+}
+
+//
+// Delayed assignment is dropped from the event queue, by finish()
+// or when the simulator is destroyed: remove it from the waveform, and free.
+//
+void transaction_base_t::drop()
+{
+    transaction_base_t **ptr = &signal.waveform;
+    while (*ptr != this)
+        ptr = &(*ptr)->next_pending;
+    *ptr = next_pending;
+    delete this;
+}
+
+//
+// Wait for the signal with timeout.
+// The process is put both to the event queue and to the sensitivity list:
+// whichever fires first, cancels the other.
+//
+timed_wait_t simulator_t::wait(signal_base_t &sig, int edge, uint64_t timeout)
+{
+    return timed_wait_t(*this, sig, edge, timeout);
+}
 
-    // On return, suspend the currect coroutine and switch back to sim.run().
-    return {};
+//
+// Constructor: bind the current process to the signal,
+// and schedule the timeout.
+//
+timed_wait_t::timed_wait_t(simulator_t &s, signal_base_t &sig, int edge, uint64_t timeout)
+    : sim(s), process(s.current_process()), hook(s, sig, edge)
+{
+    hook.is_timed = true;
+    process.trigger = nullptr;
+    sim.schedule(process, timeout);
 }
 
 //
-// Set value of the signal.
-// The value will be updated on next simulation cycle.
-// If the value changed, put the signal to the active list.
+// List of all signals.
+//
+signal_base_t *signal_base_t::all_signals = nullptr;
+
 //
-void simulator_t::set(signal_t &signal, uint64_t v)
+// Put a new signal to the list of all signals.
+//
+signal_base_t::signal_base_t(name_t n) : link(all_signals), link_pprev(&all_signals), name(n)
 {
-    signal.new_value = v;
+    if (link != nullptr)
+        link->link_pprev = &link;
+    all_signals = this;
+}
 
-    if (v != signal.value && !signal.is_active) {
-        // Value has changed - put to the list of active signals.
-        signal.is_active = true;
-        signal.next = active_signals;
-        active_signals = &signal;
+//
+// Destructor: remove the signal from the list of all signals, in O(1).
+// Pending delayed assignments to the signal are removed from the event queue.
+//
+signal_base_t::~signal_base_t()
+{
+    *link_pprev = link;
+    if (link != nullptr)
+        link->link_pprev = link_pprev;
 
-        // std::cout << '(' << time_ticks << ") Signal '" << signal.name
-        //          << "' changed = " << signal.new_value << std::endl;
+    while (waveform != nullptr) {
+        transaction_base_t *t = waveform;
+        waveform = t->next_pending;
+        if (t->is_pending())
+            simulator_t::unschedule(*t);
+        delete t;
     }
 }
 
@@ -179,7 +781,7 @@ void simulator_t::set(signal_t &signal, uint64_t v)
 // Constructor: bind the current process to a signal,
 // sensitive to the specified edge (positive or negative or both).
 //
-sensitivity_t::sensitivity_t(simulator_t &sim, signal_t &sig, int which_edge)
+sensitivity_t::sensitivity_t(simulator_t &sim, signal_base_t &sig, int which_edge)
     : process(sim.current_process()), signal(sig), edge(which_edge)
 {
     // Add this hook to the sensitivity list of the given signal.
@@ -205,3 +807,50 @@ sensitivity_t::~sensitivity_t()
         signal.hook_list = next;
     }
 }
+
+//
+// Constructor: bind the current process to the clock edge,
+// and link the hook to all inputs.
+// The process is activated on the first edge.
+//
+clocked_t::clocked_t(simulator_t &sim, signal_base_t &clk, int which_edge,
+                     std::initializer_list<signal_base_t *> input_signals)
+    : sensitivity_t(sim, clk, which_edge)
+{
+    is_clocked = true;
+
+    // Allocate all links at once, as they are referenced by address.
+    inputs.reserve(input_signals.size());
+    for (signal_base_t *sig : input_signals) {
+        clocked_input_t &in = inputs.emplace_back(nullptr, &sig->input_list, *this, *sig);
+        in.next = sig->input_list;
+        if (in.next != nullptr)
+            in.next->pprev = &in.next;
+        sig->input_list = &in;
+    }
+}
+
+//
+// Destructor: unbind the process from the inputs.
+//
+clocked_t::~clocked_t()
+{
+    for (auto &in : inputs) {
+        *in.pprev = in.next;
+        if (in.next != nullptr)
+            in.next->pprev = in.pprev;
+    }
+}
+
+//
+// Check whether some input changes in the current delta cycle.
+// Inputs, committed before the clock, have already cleared the idle flag.
+//
+bool clocked_t::has_pending_inputs() const
+{
+    for (auto &in : inputs) {
+        if (in.signal.is_active && in.signal.is_changed)
+            return true;
+    }
+    return false;
+}
@@ -21,10 +21,78 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 //
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
 #include <coroutine>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <istream>
 #include <list>
+#include <map>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "names.h"
+
+class simulator_t;
+
+//
+// Pool of coroutine frames.
+// Freed frames are kept in lists by size, and reused for new coroutines,
+// so that processes spawned for every transaction need no heap allocation.
+// Memory is bounded by the peak number of live frames.
+//
+class frame_pool_t {
+private:
+    static constexpr size_t GRANULE = 64;       // Sizes are rounded up to this
+    static constexpr unsigned NUM_CLASSES = 64; // Frames up to 4 kbytes are pooled
+
+    // Free frame.
+    struct free_t {
+        free_t *next; // Next frame of the same size
+    };
+    static inline thread_local free_t *free_lists[NUM_CLASSES]; // Free frames by size
+
+public:
+    // Allocate a frame: reuse a free one of the same size, when available.
+    static void *allocate(size_t size)
+    {
+        size_t n = (size + GRANULE - 1) / GRANULE;
+        if (n >= NUM_CLASSES)
+            return ::operator new(size);
+
+        free_t *frame = free_lists[n];
+        if (frame == nullptr)
+            return ::operator new(n * GRANULE);
+        free_lists[n] = frame->next;
+        return frame;
+    }
+
+    // Put the frame to the free list.
+    static void release(void *ptr, size_t size)
+    {
+        size_t n = (size + GRANULE - 1) / GRANULE;
+        if (n >= NUM_CLASSES) {
+            ::operator delete(ptr);
+            return;
+        }
+        free_t *frame = static_cast<free_t *>(ptr);
+        frame->next = free_lists[n];
+        free_lists[n] = frame;
+    }
+};
 
 //
 // Return type for coroutines.
@@ -35,13 +103,30 @@ class co_void_t {
 public:
     // This structure defines the behavior of the coroutine:
     // (1) suspend initially right before executing the target routine;
-    // (2) suspend when done, let caller destroy the handle.
+    // (2) suspend when done: the simulator switches to the next process,
+    //     and destroys the frame at the end of delta cycle.
     struct promise_type {
+        std::coroutine_handle<> *continuation{ nullptr }; // Where the scheduler resumes the process
+        simulator_t *sim{ nullptr };                      // Simulator which runs the process
+        std::exception_ptr exception;                     // Exception which has ended the process
+
+        // When done, notify the simulator and switch to the next process.
+        struct final_awaiter_t {
+            constexpr bool await_ready() const noexcept { return false; }
+            constexpr void await_resume() const noexcept {}
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<promise_type> handle) noexcept;
+        };
+
         co_void_t get_return_object() { return { *this }; }
         std::suspend_always initial_suspend() { return {}; }
-        std::suspend_always final_suspend() noexcept { return {}; }
-        void unhandled_exception() {}
+        final_awaiter_t final_suspend() noexcept { return {}; }
+        void unhandled_exception() { exception = std::current_exception(); }
         void return_void() noexcept {}
+
+        // Frames are allocated from the pool.
+        static void *operator new(size_t size) { return frame_pool_t::allocate(size); }
+        static void operator delete(void *ptr, size_t size) { frame_pool_t::release(ptr, size); }
     };
 
     // Constructor: extract the coroutine handle from promise.
@@ -53,6 +138,133 @@ public:
     // Return the handle, cast to void value.
     operator std::coroutine_handle<>() const { return handle; }
 
+    // Set location of the resume point of the process.
+    // Nested tasks update it, so that the scheduler resumes the innermost one.
+    void set_continuation(std::coroutine_handle<> *ptr) { handle.promise().continuation = ptr; }
+
+    // Set simulator, to notify when the process is done.
+    void set_simulator(simulator_t *s) { handle.promise().sim = s; }
+
+private:
+    // Store the coroutine handle here.
+    std::coroutine_handle<promise_type> handle;
+};
+
+//
+// Common part of promise for task_t.
+//
+struct task_promise_base_t {
+    std::coroutine_handle<> caller;                   // Coroutine which awaits this task
+    std::coroutine_handle<> *continuation{ nullptr }; // Where the scheduler resumes the process
+    std::exception_ptr exception;                     // Exception to rethrow in the caller
+
+    // When done, transfer control back to the caller.
+    struct final_awaiter_t {
+        constexpr bool await_ready() const noexcept { return false; }
+        constexpr void await_resume() const noexcept {}
+
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept
+        {
+            auto &promise = handle.promise();
+            if (promise.continuation != nullptr)
+                *promise.continuation = promise.caller;
+            return promise.caller;
+        }
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    final_awaiter_t final_suspend() noexcept { return {}; }
+    void unhandled_exception() { exception = std::current_exception(); }
+};
+
+//
+// Promise for task_t, which stores the returned value.
+//
+template <typename T>
+struct task_promise_t : task_promise_base_t {
+    std::optional<T> value; // Value returned by co_return
+
+    void return_value(T v) { value = std::move(v); }
+
+    T result()
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct task_promise_t<void> : task_promise_base_t {
+    void return_void() noexcept {}
+
+    void result()
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+};
+
+//
+// Return type for nested coroutines: a subroutine of a process,
+// which can be awaited and can return a value:
+//
+//      task_t<uint64_t> read_bus(simulator_t &sim, uint64_t addr) { ...; co_return data; }
+//      ...
+//      uint64_t data = co_await read_bus(sim, 0x100);
+//
+// Control is transferred directly from caller to callee and back
+// (symmetric transfer), without returning to the scheduler and without
+// growing the stack (GCC needs -O2 or -foptimize-sibling-calls for that).
+// The task can suspend on any simulator awaitable:
+// the scheduler then resumes the innermost task.
+//
+template <typename T = void>
+class task_t {
+public:
+    struct promise_type : task_promise_t<T> {
+        task_t get_return_object()
+        {
+            return task_t(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    // Constructor: take ownership of the coroutine handle.
+    explicit task_t(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    // Move constructor.
+    task_t(task_t &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    // Forbid the copy constructor.
+    task_t(const task_t &) = delete;
+
+    // Destructor: destroy the coroutine frame.
+    ~task_t()
+    {
+        if (handle)
+            handle.destroy();
+    }
+
+    constexpr bool await_ready() const noexcept { return false; }
+
+    // Start the task: transfer control directly to it.
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept
+    {
+        auto &promise = handle.promise();
+        promise.caller = caller;
+        if constexpr (requires { caller.promise().continuation; }) {
+            promise.continuation = caller.promise().continuation;
+            if (promise.continuation != nullptr)
+                *promise.continuation = handle;
+        }
+        return handle;
+    }
+
+    // Return the value of the task, or rethrow its exception.
+    T await_resume() { return handle.promise().result(); }
+
 private:
     // Store the coroutine handle here.
     std::coroutine_handle<promise_type> handle;
@@ -61,48 +273,327 @@ private:
 //
 // Forward declarations.
 //
-class signal_t;
+class signal_base_t;
+template <typename T>
+class typed_signal_t;
+using signal_t = typed_signal_t<uint64_t>;
 class sensitivity_t;
+class clocked_t;
+struct clocked_input_t;
+struct trigger_t;
+template <unsigned N>
+class wait_t;
+class timed_wait_t;
+class process_t;
+template <unsigned N>
+class logic_t;
+template <unsigned N>
+class driver_t;
+class transaction_base_t;
+template <typename T>
+class transaction_t;
+class join_t;
+class clock_timer_t;
+class injected_t;
+class coverage_t;
+
+// Routine to drive a clock signal of some type to a given level.
+using clock_drive_t = void (*)(simulator_t &sim, signal_base_t &sig, bool level);
+
+//
+// Member of the event queue: either a process itself,
+// or an action (like alarm) which is invoked when due.
+//
+class event_t {
+    friend class simulator_t;
+
+private:
+    event_t *next{ nullptr };   // Member of event queue
+    event_t **pprev{ nullptr }; // Link to this event, when in the queue
+    uint64_t delay{ 0 };        // Time to wait, relative to the previous event
+
+protected:
+    process_t *process; // Process to activate, or nullptr
+
+public:
+    // Allocate an event for a given process.
+    explicit event_t(process_t *p) : process(p) {}
+
+    // Forbid the copy constructor.
+    event_t(const event_t &) = delete;
+
+    // Check whether the event is in the queue.
+    bool is_pending() const { return pprev != nullptr; }
+};
 
 //
-// Info about the process.
+// Info about the process, used by the scheduler.
+// Only hot fields are kept here, so that a process takes 56 bytes.
+// Rarely used data is kept by the simulator in a side table, indexed by id.
 //
-class process_t {
+class process_t : public event_t {
     friend class simulator_t;
+    friend class timed_wait_t;
+    template <unsigned N>
+    friend class wait_t;
 
 private:
-    process_t *next{ nullptr };             // Member of event queue
-    std::string name;                       // Name for log file
-    uint64_t delay{ 0 };                    // Time to wait
     std::coroutine_handle<> continuation{}; // Handle for coroutine continuation
+    sensitivity_t *trigger{ nullptr };      // Hook which activated the process
+    uint32_t id;                            // Index in the table of processes
+    name_t name;                            // Name for log file
 
 public:
-    // Allocate a process with given name.
-    explicit process_t(const std::string &n) : name(n) {}
+    // Allocate a process with given id and name.
+    process_t(uint32_t i, name_t n) : event_t(this), id(i), name(n) {}
+
+    // Get id: index in the table of processes, in order of creation.
+    uint32_t get_id() const { return id; }
+
+    // Get full name.
+    std::string get_name() const { return name.str(); }
+
+    // Get hierarchical name.
+    name_t get_path() const { return name; }
+
+    // Get index of the instance, for processes created by make_processes().
+    uint32_t get_index() const { return name.index(); }
+};
+
+//
+// Action in the event queue: an event which is not a process.
+// The scheduler invokes it when due.
+//
+class action_t : public event_t {
+    friend class simulator_t;
+
+protected:
+    // Allocate an action, optionally related to a process.
+    explicit action_t(process_t *p) : event_t(p) {}
+
+    // Destructor.
+    virtual ~action_t() = default;
+
+    // Invoked by the scheduler when due.
+    virtual void fire(simulator_t &sim) = 0;
 
-    // Get name.
-    const std::string &get_name() { return name; }
+    // Invoked when the action is dropped from the queue without firing.
+    virtual void drop() {}
+};
+
+//
+// Reference to a process which may finish, for join().
+// The generation tells apart processes which have reused the same id.
+//
+struct process_handle_t {
+    uint32_t id;         // Index in the table of processes
+    uint32_t generation; // Generation of the id
 };
 
 //
 // Info for co_await, to switch from coroutine back to sim.run().
+// When simulator is given, switch directly to the next process
+// of the current delta cycle, if any.
 //
 struct co_await_t {
+    simulator_t *sim{ nullptr }; // Simulator, or nullptr to return to sim.run()
+
     constexpr bool await_ready() const noexcept { return false; }
-    void await_suspend(std::coroutine_handle<> handle) {}
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle) const noexcept;
     constexpr void await_resume() const noexcept {}
 };
 
+// What to do when a process fails with an exception.
+enum {
+    FAULT_STOP,    // Stop at the end of delta cycle, and rethrow from run()
+    FAULT_ISOLATE, // Terminate the process, and continue the simulation
+};
+
+//
+// Process which has failed with an exception.
+//
+struct process_fault_t {
+    name_t process;               // Name of the process
+    uint64_t time;                // Simulated time of the failure
+    std::exception_ptr exception; // Exception, not handled by the process
+};
+
+//
+// Combinational loop: too many delta cycles at one time step.
+//
+struct oscillation_t {
+    uint64_t time{ 0 };                               // Simulated time of the loop
+    uint64_t num_deltas{ 0 };                         // Delta cycles run, or 0 when no loop
+    std::vector<std::pair<name_t, uint64_t>> signals; // Signals toggled most, with changes
+};
+
+// Bits of coverage, two per signal or process.
+enum {
+    COVER_RISE = 0x1, // Signal has changed from zero to non-zero
+    COVER_FALL = 0x2, // Signal has changed from non-zero to zero
+    COVER_RUN = 0x1,  // Process has been started
+    COVER_WAKE = 0x2, // Process has been resumed after the first suspend
+};
+
+// Policies of real-time pacing, when simulation falls behind the wall clock.
+enum {
+    PACING_CATCH_UP, // Run at full speed until the lag is recovered
+    PACING_RESYNC,   // Keep the lag: shift the mapping of time to the wall clock
+};
+
+//
+// Statistics of real-time pacing.
+//
+struct pacing_stats_t {
+    uint64_t num_steps{ 0 };    // Time steps, paced by the wall clock
+    uint64_t num_late{ 0 };     // Steps reached after their deadline
+    uint64_t max_lag_ns{ 0 };   // Worst lag behind the deadline
+    uint64_t total_lag_ns{ 0 }; // Sum of lags of all steps
+};
+
 //
 // Discrete time simulator based on coroutines.
 //
 class simulator_t {
+    friend class timed_wait_t;
+    friend class alarm_t;
+    friend class clock_timer_t;
+    friend class join_t;
+    friend class signal_base_t;
+
 private:
-    std::list<process_t> all_processes;  // List of all processes
-    process_t *cur_proc{ nullptr };      // Current active process
-    process_t *event_queue{ nullptr };   // Queue of pending events
-    signal_t *active_signals{ nullptr }; // List of active signals for the current cycle
-    uint64_t time_ticks{ 0 };            // Simulated time
+    arena_t<process_t> all_processes;           // All processes, indexed by id
+    std::list<clock_timer_t> clock_timers;      // Timers of clock generators
+    std::atomic<injected_t *> inbox{ nullptr }; // Events from other threads, last first
+    process_t *cur_proc{ nullptr };             // Current active process
+    event_t *event_queue{ nullptr };            // Queue of pending events
+    unsigned chain_length{ 0 };                 // Processes switched to, bypassing sim.run()
+    signal_base_t *active_signals{ nullptr };   // List of active signals for the current cycle
+    uint64_t time_ticks{ 0 };                   // Simulated time
+    bool started{ false };                      // Processes have been put to the event queue
+    bool finished{ false };                     // Method finish() has been called
+    bool is_covering{ false };                  // Coverage is being collected
+    uint64_t num_glitches{ 0 };                 // Changes of signals, returned back in a delta
+    uint64_t num_suppressed{ 0 };               // Wakeups avoided on such glitches
+    uint64_t num_idle{ 0 };                     // Edges skipped by idle clocked processes
+    int fault_policy{ FAULT_STOP };             // What to do when a process fails
+    std::exception_ptr fault;                   // Exception to rethrow from run()
+    std::vector<process_fault_t> faults;        // All failures of processes
+    uint64_t delta_count{ 0 };                  // Delta cycles at the current time step
+    uint64_t delta_limit{ 100000 };             // Stop when exceeded: a combinational loop
+
+    // Changes of signals, counted in the last delta cycles before the limit.
+    // With a smaller limit, all delta cycles are counted.
+    static constexpr uint64_t OSCILLATION_WINDOW = 100;
+    uint64_t oscillation_start{ 100000 - OSCILLATION_WINDOW }; // Delta cycle to start counting
+    std::unordered_map<signal_base_t *, uint64_t> loop_toggles;
+    uint64_t loop_time{ UINT64_MAX }; // Time step of the counted changes
+    oscillation_t oscillation;
+
+    // Coverage of processes, when enabled: two bits per process.
+    std::vector<uint64_t> process_cover;      // Run and wake, by process id
+    std::map<name_t, unsigned> retired_cover; // Reclaimed processes, merged by name
+
+    // Limit of processes, switched by symmetric transfer in a row.
+    static constexpr unsigned MAX_CHAIN = 64;
+
+    // Rarely used data of a process.
+    struct process_info_t {
+        std::coroutine_handle<> coroutine; // Top level coroutine, or null when reclaimed
+        uint32_t generation;               // Incremented when the process is finished
+        uint32_t joiners;                  // List of processes waiting for this one
+        uint32_t next_joiner;              // Member of list of joiners
+        uint32_t joining;                  // Process this one waits for, or UINT32_MAX
+    };
+    std::vector<process_info_t> process_info; // Indexed by process id
+    std::vector<uint32_t> exited;             // Finished processes, to reclaim
+    std::vector<uint32_t> free_ids;           // Ids of reclaimed processes
+
+    // Suspended copy of the simulator, created by fork().
+    struct checkpoint_t {
+        int pid;        // Process id of the copy
+        int command_fd; // Pipe to resume or terminate the copy
+        int status_fd;  // Pipe closed when the resumed copy finishes
+        uint64_t time;  // Simulated time of the checkpoint
+    };
+    std::vector<checkpoint_t> checkpoints; // Pool of checkpoints, oldest first
+    unsigned max_checkpoints{ 8 };         // Limit for the pool
+
+    // Mapping of simulated time to the wall clock.
+    struct pacing_t {
+        uint64_t ns_per_tick{ 0 }; // Duration of a tick, or 0 when disabled
+        int policy;                // What to do when behind the wall clock
+        uint64_t base_ns;          // Wall-clock time of the base tick
+        uint64_t base_ticks;       // Base tick of the mapping
+    };
+    pacing_t pacing;             // Real-time mode
+    pacing_stats_t pacing_stats; // Lag statistics
+
+    // Put all processes to the event queue, once.
+    void start();
+
+    // Destroy frames of finished processes, and free their ids.
+    void reclaim();
+
+    // Remove the process from the list of joiners, when woken otherwise.
+    void leave_joiners(uint32_t id);
+
+    // Schedule processes for active signals, and update the signals.
+    void commit_signals();
+
+    // Check whether a change of the signal activates the hook.
+    static bool can_activate(const sensitivity_t &hook, const signal_base_t &sig);
+
+    // Check whether the hook is a clocked process with nothing to do.
+    static bool is_idle(const sensitivity_t &hook);
+
+    // Setup a new value of the signal.
+    static void commit_value(signal_base_t &sig);
+
+    // Put the process to the head of the event queue.
+    void activate(process_t &proc);
+
+    // Put the event to the queue, after a given delay.
+    void schedule(event_t &ev, uint64_t num_clocks);
+
+    // Remove the event from the queue.
+    // It needs no simulator: the event is linked to its neighbours.
+    static void unschedule(event_t &ev);
+
+    // Remove all events from the queue.
+    void drop_events();
+
+    // Move events from other threads to the event queue.
+    void drain_inbox();
+
+    // Cancel delayed assignments to the signal, due at or after a given time.
+    void cancel_transactions(signal_base_t &signal, uint64_t from);
+
+    // Connect a clock signal to a timer with given parameters.
+    bool add_clock(signal_base_t &clk, clock_drive_t drive, uint64_t period, uint64_t high,
+                   uint64_t phase);
+
+    // Run the simulation until the time limit, or for one delta cycle.
+    bool simulate(uint64_t limit, bool one_delta);
+
+    // Count changes of signals near the limit of delta cycles.
+    bool track_oscillation();
+
+    // Update coverage of the current process.
+    void cover_process();
+
+    // Update coverage of a changed signal.
+    static void cover_signal(signal_base_t &sig);
+
+    // Keep coverage of a reclaimed process.
+    void retire_coverage(const process_t &proc);
+
+    // Terminate the copy and remove it from the pool.
+    void drop_checkpoint(unsigned index);
+
+    // Wait for the wall-clock deadline of a given tick.
+    // Return false when an event from another thread has arrived meanwhile.
+    bool pace(uint64_t ticks);
 
 public:
     // Default constructor.
@@ -119,21 +610,160 @@ public:
     //
     uint64_t time() const { return time_ticks; }
 
+    //
+    // Return the number of glitches: signals which have changed
+    // and returned to the old value in the same delta cycle.
+    // Processes are not activated on a glitch: return the number
+    // of such suppressed wakeups.
+    //
+    uint64_t glitch_count() const { return num_glitches; }
+    uint64_t suppressed_wakeups() const { return num_suppressed; }
+
+    //
+    // Return the number of clock edges skipped by clocked processes,
+    // when their inputs have not changed.
+    //
+    uint64_t idle_wakeups() const { return num_idle; }
+
+    //
+    // Set limit of delta cycles at one time step, 0 for no limit.
+    // When exceeded, the simulation is finished, and the loop is reported:
+    // signals changed in the last min(limit, 100) delta cycles.
+    //
+    void set_delta_limit(uint64_t limit)
+    {
+        delta_limit = (limit == 0) ? UINT64_MAX : limit;
+        oscillation_start = delta_limit - std::min(delta_limit, OSCILLATION_WINDOW);
+    }
+
+    //
+    // Get the combinational loop which has stopped the simulation, if any.
+    //
+    const oscillation_t &get_oscillation() const { return oscillation; }
+
+    //
+    // Collect toggle coverage of signals, and activation coverage of processes.
+    //
+    void enable_coverage();
+
+    //
+    // Add coverage of this run to a given database.
+    //
+    void collect_coverage(coverage_t &cov) const;
+
+    //
+    // Set policy for failed processes: FAULT_STOP or FAULT_ISOLATE.
+    // Either way, a failed process is terminated, and the failure is recorded.
+    //
+    void set_fault_policy(int policy) { fault_policy = policy; }
+
+    //
+    // Get failures of processes, in order of time.
+    //
+    const std::vector<process_fault_t> &get_faults() const { return faults; }
+
     //
     // Create a process with given name and given top level routine.
     //
-    void make_process(const std::string &name, co_void_t (*func)(simulator_t &sim));
+    void make_process(name_t name, co_void_t (*func)(simulator_t &sim));
+
+    //
+    // Start a new process from a coroutine, at any time.
+    // During simulation, the process runs in the current delta cycle.
+    // When the coroutine returns, the process is removed, its frame
+    // is returned to the pool, and its id is reused.
+    // Return handle of the process, for join():
+    //      auto h = sim.spawn("tx", do_transaction(sim, addr, data));
+    //
+    process_handle_t spawn(name_t name, co_void_t co);
+
+    //
+    // Wait until the process is finished. It's ready at once,
+    // when the process is already finished:
+    //      co_await sim.join(h);
+    //
+    join_t join(process_handle_t h);
+
+    //
+    // Check whether the process is still running.
+    //
+    bool is_alive(process_handle_t h) const
+    {
+        return process_info[h.id].generation == h.generation;
+    }
+
+    //
+    // Get handle of a running process, to check it later by is_alive().
+    //
+    process_handle_t get_handle(const process_t &proc) const
+    {
+        return { proc.id, process_info[proc.id].generation };
+    }
+
+    //
+    // Create processes for a number of instances of a module, in bulk.
+    // Names are parent.leaf[i], and each process can get its index
+    // by current_process().get_index(). Signals of the instances
+    // are created in bulk by signal_array_t.
+    //
+    void make_processes(name_t parent, const std::string &leaf, uint32_t count,
+                        co_void_t (*func)(simulator_t &sim));
+
+    //
+    // Create a clock generator on a bool or integer signal.
+    // The clock has given period, stays high for given number of ticks,
+    // and has the first positive edge after a phase delay.
+    // Edges are applied by the scheduler, without resuming any process,
+    // and clocks with the same parameters share one timer.
+    // Return false when parameters are invalid.
+    //
+    template <typename T>
+    requires std::is_integral_v<T>
+    bool make_clock(typed_signal_t<T> &clk, uint64_t period, uint64_t high, uint64_t phase = 0);
 
     //
-    // Run the simulation.
+    // Run the simulation until no events are left, or finish() is called.
+    // Can be called again to continue after run_until() or step_delta().
     //
     void run();
 
     //
-    // Finish the simulation.
+    // Run the simulation until the given time, and return control to the caller.
+    // Events scheduled later than the limit stay pending.
+    // Return false when no events are left, or the simulation is finished.
+    //
+    bool run_until(uint64_t limit);
+
+    //
+    // Run the simulation for a given number of clock ticks.
+    //
+    bool run_for(uint64_t num_clocks);
+
+    //
+    // Run one delta cycle: resume processes ready at the current time
+    // (or at the time of the next event), and update signals they have changed.
+    //
+    bool step_delta();
+
+    //
+    // Finish the simulation: drop all pending events.
+    // This is permanent: run(), run_until(), run_for() and step_delta()
+    // return false at once after it. Processes waiting for time, timed waits
+    // and clocks are gone, so the simulation cannot be continued.
+    // To go back in time, use checkpoint() and rewind().
     //
     void finish();
 
+    //
+    // Invoke a routine at a given time, from any thread, while the simulation runs.
+    // Events are received at boundaries of time steps, and put to the event queue,
+    // in order of arrival for the same time. An event for the past time
+    // is invoked at the current time. In real-time mode, the wait for
+    // the wall clock is cut short by a new event. Thread-safe and lock-free:
+    //      sim.inject(t, [&](simulator_t &s) { s.set(irq, 1); });
+    //
+    void inject(uint64_t when, std::function<void(simulator_t &)> func);
+
     //
     // Delay the current process by a given number of clock ticks.
     // Return awaitable object.
@@ -143,61 +773,320 @@ public:
     co_await_t delay(uint64_t num_clocks);
 
     //
-    // Update value of signal.
+    // Wait for activation by sensitivity hooks of the current process.
+    // This routine should be invoked as:
+    //      co_await sim.wait();
     //
-    void set(signal_t &signal, uint64_t value);
+    co_await_t wait() { return { this }; }
 
     //
-    // Get current process.
+    // Wait for a change of the signal, or for the specified edge.
+    // Return awaitable object, with the sensitivity hook inside.
+    // This routine should be invoked as:
+    //      co_await sim.wait(clk, POSEDGE);
     //
-    process_t &current_process() { return *cur_proc; }
-};
+    wait_t<1> wait(signal_base_t &sig, int edge = 0);
 
-//
-// Signal: a value that may change and activate some processes.
-//
-class signal_t {
-    friend class simulator_t;
-    friend class sensitivity_t;
+    //
+    // Wait for any of the given signals: each argument is either a signal
+    // (any change), or a trigger like posedge(clk).
+    // Awaiting returns the index of the argument which has fired,
+    // or the number of arguments when the process has been woken up
+    // otherwise, like by interrupt() or an alarm:
+    //      unsigned i = co_await sim.wait_any(a, b, posedge(clk));
+    //
+    template <typename... T>
+    wait_t<sizeof...(T)> wait_any(T &&...triggers);
 
-private:
-    signal_t *next{ nullptr };           // Member of active list
-    sensitivity_t *hook_list{ nullptr }; // Sensitivity list: processes to activate
-    const std::string name;              // Name for log file
-    uint64_t value;                      // Current value
-    uint64_t new_value;                  // Value for next cycle
-    bool is_active{ false };             // When value has changed
+    //
+    // Wait for the signal, but no longer than a given number of clock ticks.
+    // Awaiting returns true when the signal has fired, or false on timeout:
+    //      if (!co_await sim.wait(ack, POSEDGE, 100)) { ... }
+    //
+    timed_wait_t wait(signal_base_t &sig, int edge, uint64_t timeout);
 
-public:
-    // Allocate a signal with given name and optional value.
-    explicit signal_t(const std::string &n, uint64_t v = 0) : name(n), value(v), new_value(v) {}
+    //
+    // Activate the process in the current delta cycle.
+    // Pending delay or timeout of the process is cancelled.
+    // A finished process is ignored. Use the handle when the process
+    // may have finished, and its id may be reused by a new process.
+    //
+    void interrupt(process_t &proc);
+    void interrupt(process_handle_t h);
 
-    // Get current value.
-    uint64_t get() { return value; }
+    //
+    // Update value of signal.
+    //
+    template <typename T>
+    void set(typed_signal_t<T> &signal, const std::type_identity_t<T> &value);
 
-    // Get name.
-    const std::string &get_name() { return name; }
-};
+    //
+    // Update contribution of a driver to a resolved signal.
+    // Defined in resolved.h.
+    //
+    template <unsigned N>
+    void set(driver_t<N> &driver, const logic_t<N> &value);
 
-//
-// Sensitivity hook: connect a process to a signal.
-//
-class sensitivity_t {
-    friend class simulator_t;
+    //
+    // Update value of signal after a given number of clock ticks,
+    // like b <= #3 a in Verilog. No process is resumed for that.
+    // With DELAY_INERTIAL, the assignment cancels all pending assignments
+    // to this signal, so pulses shorter than the delay are filtered out.
+    // With DELAY_TRANSPORT, it cancels only those due at or after its time.
+    //
+    template <typename T>
+    void set_after(typed_signal_t<T> &signal, const std::type_identity_t<T> &value,
+                   uint64_t num_clocks, int mode);
 
-private:
-    sensitivity_t *next, *prev; // Member of sensitivity list
-    process_t &process;         // Process to activate
-    signal_t &signal;           // Signal to be activated from
-    int edge;                   // Edge, if nonzero
+    //
+    // Get current process.
+    //
+    process_t &current_process() { return *cur_proc; }
 
-public:
-    // Constructor: bind the current process to a signal,
-    // sensitive to the specified edge (positive or negative or both).
-    explicit sensitivity_t(simulator_t &sim, signal_t &sig, int which_edge = 0);
+    //
+    // Get process by id, and number of processes.
+    //
+    process_t &get_process(uint32_t id) { return all_processes[id]; }
+    uint32_t num_processes() const { return all_processes.size(); }
 
-    // Destructor: unbind the process from the signal.
-    ~sensitivity_t();
+    //
+    // Select next process of the current delta cycle, and return its continuation.
+    // At the end of delta cycle, return noop handle to switch back to sim.run().
+    // Used by awaitable objects for symmetric transfer between processes.
+    //
+    std::coroutine_handle<> next_process();
+
+    //
+    // Current process is done: wake up its joiners, and select next process.
+    // Used by co_void_t at the final suspend point, with an exception
+    // when the process has failed.
+    //
+    std::coroutine_handle<> exit_process(const std::exception_ptr &exception);
+
+    //
+    // Save values of all signals to a file, with pending changes
+    // of the current delta cycle and pending delayed assignments.
+    // This is a dump of signals, not of the whole simulation:
+    // processes and other events are not saved.
+    // For exact restore, use checkpoint() and rewind().
+    // Return false on I/O error.
+    //
+    bool save(const std::string &path) const;
+
+    //
+    // Restore values of signals from a file, created by save().
+    // Delayed assignments to the restored signals are replaced by the saved ones.
+    // Before the start of simulation, time is set to the saved one, so that
+    // a long run can be resumed by new processes. After the start, the file
+    // must have the current time. Processes and other pending events
+    // of this simulator are kept as is. A simulation, stopped by finish(),
+    // stays finished.
+    // Return false when the file cannot be read, or it does not match
+    // the signals or the time of this simulator.
+    //
+    bool restore(const std::string &path);
+
+    //
+    // Take a checkpoint: fork() a copy of the simulator, which stays suspended
+    // until rewind() is called. At most max_checkpoints are kept: when
+    // the pool is full, the oldest checkpoint is dropped.
+    // Return false when the checkpoint is taken,
+    // and true in the copy, when it has been resumed by rewind().
+    //
+    bool checkpoint();
+
+    //
+    // Set limit for the pool of checkpoints.
+    //
+    void set_max_checkpoints(unsigned n);
+
+    //
+    // Get number of checkpoints in the pool.
+    //
+    unsigned num_checkpoints() const { return checkpoints.size(); }
+
+    //
+    // Get simulated time of the n-th latest checkpoint (1 = the most recent one).
+    //
+    uint64_t checkpoint_time(unsigned n) const { return checkpoints[checkpoints.size() - n].time; }
+
+    //
+    // Resume the n-th latest checkpoint (1 = the most recent one).
+    // Newer checkpoints are dropped. The current process waits
+    // until the resumed simulation finishes, and then exits
+    // with the same status.
+    // Return false when there is no such checkpoint.
+    //
+    bool rewind(unsigned n = 1);
+
+    //
+    // Fork the simulator into a given number of branches, running in parallel.
+    // Return branch number (0...N-1) in each copy: the caller should apply
+    // different stimulus depending on it. In the original process,
+    // wait until all branches finish and return -1, or -2 when
+    // some branches could not be started.
+    //
+    int fan_out(unsigned num_branches);
+
+    //
+    // Run in real time: map one tick to a given number of nanoseconds
+    // of the wall clock, starting from now. Zero disables the mode.
+    // Before time advances, the simulator sleeps until the deadline,
+    // and spins for the last few microseconds, for low jitter.
+    //
+    void set_realtime(uint64_t ns_per_tick, int policy = PACING_CATCH_UP);
+
+    //
+    // Get lag statistics of real-time mode.
+    //
+    const pacing_stats_t &get_pacing_stats() const { return pacing_stats; }
+};
+
+//
+// Select next process of the current delta cycle, and return its continuation.
+// Alarms and time advance are left for sim.run().
+// Without sibling call optimization (like at -O0), every transfer
+// takes stack space: after MAX_CHAIN transfers, switch back to sim.run().
+//
+inline std::coroutine_handle<> simulator_t::next_process()
+{
+    event_t *ev = event_queue;
+    if (ev == nullptr || ev->delay != 0 || ev != ev->process || ++chain_length > MAX_CHAIN)
+        return std::noop_coroutine();
+
+    event_queue = ev->next;
+    if (event_queue != nullptr)
+        event_queue->pprev = &event_queue;
+    ev->pprev = nullptr;
+    cur_proc = ev->process;
+    if (is_covering)
+        cover_process();
+    return cur_proc->continuation;
+}
+
+//
+// Suspend the current coroutine and switch to the next process, if any.
+//
+inline std::coroutine_handle<> co_await_t::await_suspend(
+    std::coroutine_handle<> handle) const noexcept
+{
+    if (sim == nullptr)
+        return std::noop_coroutine();
+    return sim->next_process();
+}
+
+//
+// Process is done: switch to the next process, if any.
+// Without a simulator, return to the caller of resume().
+//
+inline std::coroutine_handle<> co_void_t::promise_type::final_awaiter_t::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept
+{
+    simulator_t *sim = handle.promise().sim;
+    if (sim == nullptr)
+        return std::noop_coroutine();
+    return sim->exit_process(handle.promise().exception);
+}
+
+//
+// Awaitable for join(): suspend until the process is finished.
+//
+class join_t {
+private:
+    simulator_t &sim;        // Simulator which runs the process
+    process_handle_t target; // Process to wait for
+
+public:
+    join_t(simulator_t &s, process_handle_t h) : sim(s), target(h) {}
+
+    // Ready when the process is already finished.
+    bool await_ready() const noexcept { return !sim.is_alive(target); }
+
+    // Add the current process to joiners of the target, and switch to the next process.
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept
+    {
+        auto &info = sim.process_info[target.id];
+        auto &self = sim.process_info[sim.cur_proc->get_id()];
+
+        self.next_joiner = info.joiners;
+        self.joining = target.id;
+        info.joiners = sim.cur_proc->get_id();
+        return sim.next_process();
+    }
+
+    // When woken up otherwise, like by interrupt(), stop waiting for the target.
+    void await_resume() const noexcept
+    {
+        uint32_t self = sim.cur_proc->get_id();
+        if (sim.process_info[self].joining != UINT32_MAX)
+            sim.leave_joiners(self);
+    }
+};
+
+//
+// Alarm: activate a process after a given number of clock ticks.
+// Alarm sits in the event queue independently of the process,
+// and can be cancelled or restarted without resuming the process.
+// When the alarm fires, the process is activated, interrupting
+// its pending delay if any. When the process has finished meanwhile,
+// the alarm is ignored.
+//
+class alarm_t : public action_t {
+private:
+    simulator_t &sim;        // Simulator, which owns the event queue
+    process_handle_t target; // Process to activate
+
+    // Activate the process, when still alive.
+    void fire(simulator_t &s) override { s.interrupt(target); }
+
+public:
+    // Constructor: bind the alarm to the current process.
+    explicit alarm_t(simulator_t &s) : alarm_t(s, s.current_process()) {}
+
+    // Constructor: bind the alarm to a given process.
+    alarm_t(simulator_t &s, process_t &proc)
+        : action_t(&proc), sim(s), target(s.get_handle(proc))
+    {
+    }
+
+    // Destructor: cancel the alarm.
+    ~alarm_t() { cancel(); }
+
+    // Start the alarm, or restart it when pending.
+    void start(uint64_t num_clocks);
+
+    // Cancel the alarm, when pending.
+    void cancel();
+};
+
+//
+// Event from another thread: a routine to invoke at a given time.
+// Allocated by the sender, and freed by the simulator.
+//
+class injected_t : public action_t {
+    friend class simulator_t;
+
+private:
+    injected_t *next_injected{ nullptr };    // Member of inbox
+    uint64_t when;                           // Time to invoke
+    std::function<void(simulator_t &)> func; // Routine to invoke
+
+    // Invoke the routine, and free the event.
+    void fire(simulator_t &sim) override
+    {
+        func(sim);
+        delete this;
+    }
+
+    // Free the event.
+    void drop() override { delete this; }
+
+public:
+    // Allocate an event.
+    injected_t(uint64_t t, std::function<void(simulator_t &)> &&f)
+        : action_t(nullptr), when(t), func(std::move(f))
+    {
+    }
 };
 
 // Values for sensitivity_t::edge.
@@ -207,34 +1096,601 @@ enum {
 };
 
 //
-// Wait for the signal.
-// Hook, wait, then unhook.
+// Types of values, which have edges: bool and integers,
+// or any type with a function signal_edges(from, to), found by ADL,
+// which returns POSEDGE, NEGEDGE or none for a change.
+//
+template <typename T>
+concept has_edges = std::is_integral_v<T> || requires(const T &v) {
+    { signal_edges(v, v) } -> std::convertible_to<int>;
+};
+
+//
+// Signal: a value that may change and activate some processes.
+// This part does not depend on the type of the value.
+//
+class signal_base_t {
+    friend class simulator_t;
+    friend class sensitivity_t;
+    friend class transaction_base_t;
+    friend class clocked_t;
+
+private:
+    signal_base_t *next{ nullptr };          // Member of active list
+    sensitivity_t *hook_list{ nullptr };     // Sensitivity list: processes to activate
+    signal_base_t *link;                     // Member of list of all signals
+    signal_base_t **link_pprev;              // Link to this signal in the list
+    transaction_base_t *waveform{ nullptr }; // Delayed assignments, in order of time
+    clocked_input_t *input_list{ nullptr };  // Clocked processes with this input
+    bool is_active{ false };                 // When value has changed
+    uint8_t cover{ 0 };                      // Edges seen, when coverage is enabled
+    name_t name;                             // Name for log file
+
+    static signal_base_t *all_signals; // List of all signals
+
+protected:
+    bool is_changed{ false }; // New value differs from the current one
+    bool is_word{ false };    // Plain 64-bit value: committed without a virtual call
+
+    // Get edges of the pending change: POSEDGE, NEGEDGE or none.
+    virtual int get_edges() const = 0;
+
+    // Setup a new value at the end of delta cycle.
+    virtual void commit() = 0;
+
+    // Write current and new values to the snapshot.
+    virtual void save_value(std::ostream &out) const = 0;
+
+    // Read current and new values from the snapshot.
+    // When apply is false, only check the syntax.
+    virtual bool restore_value(std::istream &in, bool apply) = 0;
+
+    // Read value of a delayed assignment from the snapshot,
+    // and assign it after a given number of clock ticks.
+    // When apply is false, only check the syntax.
+    virtual bool restore_transaction(simulator_t &sim, std::istream &in, uint64_t delay,
+                                     bool apply) = 0;
+
+public:
+    // Put a new signal to the list of all signals.
+    explicit signal_base_t(name_t n);
+
+    // Forbid the copy constructor.
+    signal_base_t(const signal_base_t &) = delete;
+
+    // Destructor: remove from the list of all signals,
+    // and cancel pending delayed assignments.
+    virtual ~signal_base_t();
+
+    // Get full name.
+    std::string get_name() const { return name.str(); }
+
+    // Get hierarchical name.
+    name_t get_path() const { return name; }
+};
+
+// Modes for set_after().
+enum {
+    DELAY_INERTIAL,  // New assignment cancels all pending ones
+    DELAY_TRANSPORT, // New assignment cancels pending ones at or after its time
+};
+
+//
+// Signal with a value of given type: bool, integer, enum or a small struct.
+// The type must be trivially copyable.
+// Values are compared by operator==, when available, or bitwise.
+// For bool and integer types, a change from zero to non-zero
+// is a positive edge, and back is a negative one.
+// Other types have edges when signal_edges() is defined for them.
 //
-#define process_wait1(sim, _sig, _edge)         \
-    {                                           \
-        sensitivity_t _hook(_sim, _sig, _edge); \
-        co_wait co_await_t{};                   \
+template <typename T>
+class typed_signal_t : public signal_base_t {
+    static_assert(std::is_trivially_copyable_v<T>, "signal value must be trivially copyable");
+
+    friend class simulator_t;
+    friend class transaction_t<T>;
+
+private:
+    T value;     // Current value
+    T new_value; // Value for next cycle
+
+    // Compare two values.
+    static bool equal(const T &a, const T &b)
+    {
+        if constexpr (std::equality_comparable<T>)
+            return a == b;
+        else
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+
+    // Write a value: as a number, or as hex bytes.
+    static void write(std::ostream &out, const T &v)
+    {
+        if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            out << static_cast<uint64_t>(v);
+        } else {
+            static const char hex[] = "0123456789abcdef";
+            auto bytes = reinterpret_cast<const unsigned char *>(&v);
+            for (unsigned i = 0; i < sizeof(T); i++) {
+                out << hex[bytes[i] >> 4] << hex[bytes[i] & 15];
+            }
+        }
+    }
+
+    // Read a value, written by write().
+    static bool read(std::istream &in, T &v)
+    {
+        if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            uint64_t n;
+            if (!(in >> n))
+                return false;
+            v = static_cast<T>(n);
+        } else {
+            std::string word;
+            if (!(in >> word) || word.size() != 2 * sizeof(T))
+                return false;
+            auto bytes = reinterpret_cast<unsigned char *>(&v);
+            for (unsigned i = 0; i < sizeof(T); i++) {
+                int hi = hex_digit(word[2 * i]);
+                int lo = hex_digit(word[2 * i + 1]);
+                if (hi < 0 || lo < 0)
+                    return false;
+                bytes[i] = (hi << 4) | lo;
+            }
+        }
+        return true;
     }
 
+    // Convert hex digit to number, or return -1.
+    static int hex_digit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
+
+protected:
+    // Get edges of the pending change.
+    int get_edges() const override
+    {
+        if constexpr (std::is_integral_v<T>) {
+            if (value == 0 && new_value != 0)
+                return POSEDGE;
+            if (value != 0 && new_value == 0)
+                return NEGEDGE;
+        } else if constexpr (has_edges<T>) {
+            return signal_edges(value, new_value);
+        }
+        return 0;
+    }
+
+    // Setup a new value.
+    void commit() override { value = new_value; }
+
+    // Write current and new values to the snapshot.
+    void save_value(std::ostream &out) const override
+    {
+        write(out, value);
+        out << ' ';
+        write(out, new_value);
+    }
+
+    // Read current and new values from the snapshot.
+    bool restore_value(std::istream &in, bool apply) override
+    {
+        T v = value, nv = new_value;
+        if (!read(in, v) || !read(in, nv))
+            return false;
+        if (apply) {
+            value = v;
+            new_value = nv;
+            is_changed = !equal(v, nv);
+        }
+        return true;
+    }
+
+    // Read value of a delayed assignment from the snapshot, and schedule it.
+    bool restore_transaction(simulator_t &sim, std::istream &in, uint64_t delay,
+                             bool apply) override
+    {
+        T v;
+        if (!read(in, v))
+            return false;
+        if (apply)
+            sim.set_after(*this, v, delay, DELAY_TRANSPORT);
+        return true;
+    }
+
+public:
+    // Allocate a signal with given name and optional value.
+    explicit typed_signal_t(name_t n, const T &v = T{})
+        : signal_base_t(n), value(v), new_value(v)
+    {
+        is_word = std::is_same_v<T, uint64_t>;
+    }
+
+    // Get current value.
+    const T &get() const { return value; }
+};
+
 //
-// Wait for either of two signals.
-// Hook, wait, then unhook.
+// Signals for a number of instances of a module, created in bulk.
+// Names are parent.leaf[i], allocated in one range, and signals
+// are stored in an arena, like processes by make_processes():
+//      signal_array_t<int> data("top", "data", 1000);
+//      sim.set(data[sim.current_process().get_index()], 1);
+//
+template <typename T>
+class signal_array_t {
+private:
+    arena_t<typed_signal_t<T>> signals; // Signals, by index of instance
+
+public:
+    // Allocate signals parent.leaf[0] ... parent.leaf[count-1] with optional value.
+    signal_array_t(name_t parent, const std::string &leaf, uint32_t count, const T &v = T{})
+    {
+        name_t names = name_t::make_array(parent, leaf, count);
+        for (uint32_t i = 0; i < count; i++) {
+            signals.emplace_back(names[i], v);
+        }
+    }
+
+    // Get number of signals.
+    uint32_t size() const { return signals.size(); }
+
+    // Get signal by index of instance.
+    typed_signal_t<T> &operator[](uint32_t i) { return signals[i]; }
+    const typed_signal_t<T> &operator[](uint32_t i) const { return signals[i]; }
+};
+
+//
+// Update value of signal.
+// The value will be updated on next simulation cycle.
+// If the value changed, put the signal to the active list.
+// When it's set back to the old value, it stays in the list,
+// but is marked as unchanged.
 //
-#define process_wait2(sim, _sig1, _edge1, _sig2, _edge2) \
-    {                                                    \
-        sensitivity_t _hook1(_sim, _sig1, _edge1);       \
-        sensitivity_t _hook2(_sim, _sig2, _edge2);       \
-        co_wait co_await_t{};                            \
+template <typename T>
+inline void simulator_t::set(typed_signal_t<T> &signal, const std::type_identity_t<T> &v)
+{
+    bool changed = !typed_signal_t<T>::equal(v, signal.value);
+
+    signal.new_value = v;
+    signal.is_changed = changed;
+
+    if (changed && !signal.is_active) {
+        // Value has changed - put to the list of active signals.
+        signal.is_active = true;
+        signal.next = active_signals;
+        active_signals = &signal;
     }
+}
 
 //
-// Wait for either of three signals.
-// Hook, wait, then unhook.
+// Delayed assignment to a signal, as an action in the event queue.
+// Pending assignments of a signal form its projected waveform.
+//
+class transaction_base_t : public action_t {
+    friend class simulator_t;
+    friend class signal_base_t;
+
+protected:
+    signal_base_t &signal;                       // Signal to update
+    transaction_base_t *next_pending{ nullptr }; // Next in the projected waveform
+    uint64_t when;                               // Time of the assignment
+
+    // Allocate a transaction for the signal.
+    transaction_base_t(signal_base_t &sig, uint64_t t) : action_t(nullptr), signal(sig), when(t) {}
+
+    // Remove from the head of the waveform, when fired.
+    void detach() { signal.waveform = next_pending; }
+
+    // Remove from the waveform and free, when dropped from the queue.
+    void drop() override;
+
+    // Write the value to the snapshot.
+    virtual void save_value(std::ostream &out) const = 0;
+};
+
+//
+// Delayed assignment of a value of given type.
+//
+template <typename T>
+class transaction_t : public transaction_base_t {
+private:
+    T value; // Value to assign
+
+    // Assign the value, and free the transaction.
+    // It's always the earliest one in the waveform.
+    void fire(simulator_t &sim) override
+    {
+        typed_signal_t<T> &sig = static_cast<typed_signal_t<T> &>(signal);
+
+        detach();
+        sim.set(sig, value);
+        delete this;
+    }
+
+    // Write the value to the snapshot.
+    void save_value(std::ostream &out) const override { typed_signal_t<T>::write(out, value); }
+
+public:
+    // Allocate a transaction for the signal.
+    transaction_t(typed_signal_t<T> &sig, const T &v, uint64_t t)
+        : transaction_base_t(sig, t), value(v)
+    {
+    }
+};
+
+//
+// Update value of signal after a given number of clock ticks.
+//
+template <typename T>
+void simulator_t::set_after(typed_signal_t<T> &signal, const std::type_identity_t<T> &v,
+                            uint64_t num_clocks, int mode)
+{
+    uint64_t when = time_ticks + num_clocks;
+    cancel_transactions(signal, (mode == DELAY_INERTIAL) ? 0 : when);
+
+    // Append to the waveform: it's sorted by time after the cancellation.
+    auto *t = new transaction_t<T>(signal, v, when);
+    transaction_base_t **tail = &signal.waveform;
+    while (*tail != nullptr)
+        tail = &(*tail)->next_pending;
+    *tail = t;
+    schedule(*t, num_clocks);
+}
+
+//
+// Timer of clock generators with the same period, duty cycle and phase.
+// At every edge, it updates all its clocks and restarts itself.
+//
+class clock_timer_t : public action_t {
+    friend class simulator_t;
+
+private:
+    // Clock signal, driven by the timer.
+    struct output_t {
+        signal_base_t *signal; // Signal to update
+        clock_drive_t drive;   // Routine to set level of the signal
+    };
+    std::vector<output_t> outputs; // All clocks of this timer
+    uint64_t period;               // Period in ticks
+    uint64_t high;                 // Duration of high level
+    uint64_t origin;               // Time of positive edges, modulo period
+    bool level{ false };           // Current level of the clocks
+
+    // Toggle the clocks, and schedule the next edge.
+    void fire(simulator_t &sim) override;
+
+public:
+    // Allocate a timer with given parameters.
+    clock_timer_t(uint64_t p, uint64_t h, uint64_t o)
+        : action_t(nullptr), period(p), high(h), origin(o)
+    {
+    }
+};
+
+//
+// Create a clock generator on a signal.
+// Levels are converted to the type of the signal by a routine
+// without captures, so that timers can drive clocks of any type.
+//
+template <typename T>
+requires std::is_integral_v<T>
+bool simulator_t::make_clock(typed_signal_t<T> &clk, uint64_t period, uint64_t high,
+                             uint64_t phase)
+{
+    auto drive = [](simulator_t &sim, signal_base_t &sig, bool level) {
+        sim.set(static_cast<typed_signal_t<T> &>(sig), T(level));
+    };
+    return add_clock(clk, drive, period, high, phase);
+}
+
+//
+// Sensitivity hook: connect a process to a signal.
+//
+class sensitivity_t {
+    friend class simulator_t;
+
+private:
+    sensitivity_t *next, *prev; // Member of sensitivity list
+    process_t &process;         // Process to activate
+    signal_base_t &signal;      // Signal to be activated from
+    int edge;                   // Edge, if nonzero
+    bool is_timed{ false };     // Can interrupt a timed wait
+    bool is_clocked{ false };   // Process has declared its inputs
+    bool is_idle{ false };      // Inputs have not changed since activation
+
+    friend class timed_wait_t;
+    friend class clocked_t;
+
+public:
+    // Constructor: bind the current process to a signal,
+    // sensitive to the specified edge (positive or negative or both).
+    explicit sensitivity_t(simulator_t &sim, signal_base_t &sig, int which_edge = 0);
+
+    // Forbid the copy constructor.
+    sensitivity_t(const sensitivity_t &) = delete;
+
+    // Destructor: unbind the process from the signal.
+    ~sensitivity_t();
+};
+
+//
+// Link from an input signal to a clocked process.
+//
+struct clocked_input_t {
+    clocked_input_t *next;   // Member of input list of the signal
+    clocked_input_t **pprev; // Link to this item
+    sensitivity_t &hook;     // Hook of the clocked process
+    signal_base_t &signal;   // Input signal
+};
+
+//
+// Sensitivity hook of a clocked process, which declares its inputs.
+// On a clock edge, the process is activated only when some input
+// has changed since the previous activation, or when it has asked
+// to stay awake. Edges of an idle process are skipped without resume:
+//      clocked_t hook(sim, clk, POSEDGE, { &reset, &enable });
+//
+class clocked_t : public sensitivity_t {
+    friend class simulator_t;
+
+private:
+    std::vector<clocked_input_t> inputs; // Links from input signals
+
+    // Check whether some input changes in the current delta cycle,
+    // but has not been committed yet.
+    bool has_pending_inputs() const;
+
+public:
+    // Constructor: bind the current process to the clock and to the inputs.
+    clocked_t(simulator_t &sim, signal_base_t &clk, int which_edge,
+              std::initializer_list<signal_base_t *> input_signals);
+
+    // Destructor: unbind the process from the inputs.
+    ~clocked_t();
+
+    // Activate the process on the next edge, even when inputs have not changed.
+    // Used when the process has some internal state to update.
+    void keep_awake() { is_idle = false; }
+};
+
+//
+// Signal with edge, for wait_any().
+//
+struct trigger_t {
+    signal_base_t &signal; // Signal to wait for
+    int edge;              // Edge, if nonzero
+
+    trigger_t(signal_base_t &sig, int which_edge = 0) : signal(sig), edge(which_edge) {}
+};
+
+//
+// Triggers for positive and negative edges of the signal.
+// Only for signals with edges.
+//
+template <typename T>
+requires has_edges<T>
+inline trigger_t posedge(typed_signal_t<T> &sig)
+{
+    return trigger_t(sig, POSEDGE);
+}
+
+template <typename T>
+requires has_edges<T>
+inline trigger_t negedge(typed_signal_t<T> &sig)
+{
+    return trigger_t(sig, NEGEDGE);
+}
+
+//
+// Info for co_await, to wait for any of N signals.
+// Sensitivity hooks are stored inside this object, which resides
+// in the coroutine frame while the process is suspended: no heap allocation.
+// Hooks are unbound when the process resumes and this object is destroyed.
+//
+template <unsigned N>
+class wait_t {
+private:
+    simulator_t &sim;       // Simulator, to switch to the next process
+    process_t &process;     // Process to activate
+    sensitivity_t hooks[N]; // Hooks for all signals
+
+public:
+    // Constructor: bind the current process to all signals.
+    template <typename... T>
+    explicit wait_t(simulator_t &s, T &&...triggers)
+        : sim(s), process(s.current_process()),
+          hooks{ sensitivity_t(s, trigger_t(triggers).signal, trigger_t(triggers).edge)... }
+    {
+    }
+
+    constexpr bool await_ready() const noexcept { return false; }
+
+    // Switch to the next process.
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle) const noexcept
+    {
+        return sim.next_process();
+    }
+
+    // Return the index of the signal, which has activated the process,
+    // or N when activated otherwise: by interrupt(), alarm or join().
+    unsigned await_resume() const noexcept
+    {
+        for (unsigned i = 0; i < N; i++) {
+            if (process.trigger == &hooks[i])
+                return i;
+        }
+        return N;
+    }
+};
+
+//
+// Info for co_await, to wait for the signal with timeout.
+// The process is both in the event queue and in the sensitivity list of the signal.
+// When the signal fires, the timeout is removed from the queue;
+// on timeout, the hook is unbound by the destructor.
 //
-#define process_wait3(sim, _sig1, _edge1, _sig2, _edge2, _sig3, _edge3) \
-    {                                                                   \
-        sensitivity_t _hook1(_sim, _sig1, _edge1);                      \
-        sensitivity_t _hook2(_sim, _sig2, _edge2);                      \
-        sensitivity_t _hook3(_sim, _sig3, _edge3);                      \
-        co_wait co_await_t{};                                           \
+class timed_wait_t {
+private:
+    simulator_t &sim;   // Simulator, to switch to the next process
+    process_t &process; // Process to activate
+    sensitivity_t hook; // Hook for the signal
+
+public:
+    // Constructor: bind the current process to the signal, and schedule the timeout.
+    explicit timed_wait_t(simulator_t &sim, signal_base_t &sig, int edge, uint64_t timeout);
+
+    constexpr bool await_ready() const noexcept { return false; }
+
+    // Switch to the next process.
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> handle) const noexcept
+    {
+        return sim.next_process();
     }
+
+    // Return true when the signal has fired, or false on timeout.
+    bool await_resume() const noexcept { return process.trigger == &hook; }
+};
+
+//
+// Wait for a change of the signal, or for the specified edge.
+//
+inline wait_t<1> simulator_t::wait(signal_base_t &sig, int edge)
+{
+    return wait_t<1>(*this, trigger_t(sig, edge));
+}
+
+//
+// Wait for any of the given signals.
+//
+template <typename... T>
+wait_t<sizeof...(T)> simulator_t::wait_any(T &&...triggers)
+{
+    return wait_t<sizeof...(T)>(*this, triggers...);
+}
+
+//
+// Wait for the signal.
+// Kept for compatibility: use co_await sim.wait() instead.
+//
+#define process_wait1(_sim, _sig, _edge) co_await(_sim).wait(_sig, _edge)
+
+//
+// Wait for either of two signals.
+// Kept for compatibility: use co_await sim.wait_any() instead.
+//
+#define process_wait2(_sim, _sig1, _edge1, _sig2, _edge2) \
+    co_await(_sim).wait_any(trigger_t(_sig1, _edge1), trigger_t(_sig2, _edge2))
+
+//
+// Wait for either of three signals.
+// Kept for compatibility: use co_await sim.wait_any() instead.
+//
+#define process_wait3(_sim, _sig1, _edge1, _sig2, _edge2, _sig3, _edge3)       \
+    co_await(_sim).wait_any(trigger_t(_sig1, _edge1), trigger_t(_sig2, _edge2), \
+                            trigger_t(_sig3, _edge3))
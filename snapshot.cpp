@@ -0,0 +1,207 @@
+//
+// Save and restore state of the simulation.
+//
+// Copyright (c) 2021 Serge Vakulenko
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include "simulator.h"
+
+//
+// Snapshot is a dump of signals, in a text file, one item per line:
+//
+//      simulator-snapshot 3
+//      time <ticks>                                -- simulated time
+//      signal "<name>" <value> <new_value>         -- all signals
+//      active "<name>"                             -- list of active signals, in order
+//      assign "<name>" <delay> <value>             -- delayed assignments, in order of time
+//
+// Processes, their local variables, sensitivity hooks and other events
+// are not saved: a coroutine frame cannot be rebuilt from a file.
+// To resume a long run, a new simulator creates its processes,
+// restores the snapshot before the start, and the processes begin
+// at the saved time with the saved values. For exact restore
+// of the whole simulation, use checkpoints: see checkpoint.cpp.
+//
+static const std::string snapshot_magic = "simulator-snapshot";
+static const unsigned snapshot_version = 3;
+
+//
+// Save values of all signals and their delayed assignments to a file.
+// Return false on I/O error.
+//
+bool simulator_t::save(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+
+    out << snapshot_magic << ' ' << snapshot_version << '\n';
+    out << "time " << time_ticks << '\n';
+
+    for (signal_base_t *sig = signal_base_t::all_signals; sig != nullptr; sig = sig->link) {
+        out << "signal " << std::quoted(sig->get_name()) << ' ';
+        sig->save_value(out);
+        out << '\n';
+    }
+    for (signal_base_t *sig = active_signals; sig != nullptr; sig = sig->next) {
+        out << "active " << std::quoted(sig->get_name()) << '\n';
+    }
+    for (signal_base_t *sig = signal_base_t::all_signals; sig != nullptr; sig = sig->link) {
+        for (transaction_base_t *t = sig->waveform; t != nullptr; t = t->next_pending) {
+            out << "assign " << std::quoted(sig->get_name()) << ' ' << (t->when - time_ticks)
+                << ' ';
+            t->save_value(out);
+            out << '\n';
+        }
+    }
+
+    out.close();
+    return !out.fail();
+}
+
+//
+// Restore values of signals from a file, created by save().
+// Delayed assignments of the restored signals are replaced by the saved ones.
+// Before the start of simulation, time is set to the saved one.
+// After the start, time cannot change: the snapshot should be taken
+// at the current time. Processes of this simulator are not changed.
+// Return false when the file cannot be read, it has a signal which is
+// missing in this simulator, or a different time after the start:
+// nothing is changed in this case.
+//
+bool simulator_t::restore(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    // Cannot restore from inside a process.
+    if (cur_proc != nullptr)
+        return false;
+
+    std::string magic;
+    unsigned version;
+    if (!(in >> magic >> version) || magic != snapshot_magic || version != snapshot_version)
+        return false;
+
+    // Read the whole file before changing anything.
+    std::map<signal_base_t *, std::string> values;
+    std::vector<signal_base_t *> active;
+    std::vector<std::pair<signal_base_t *, std::string>> assigns;
+    uint64_t saved_time = UINT64_MAX;
+
+    std::map<std::string, signal_base_t *> signal_by_name;
+    for (signal_base_t *sig = signal_base_t::all_signals; sig != nullptr; sig = sig->link) {
+        signal_by_name.emplace(sig->get_name(), sig);
+    }
+    auto find_signal = [&](const std::string &name) -> signal_base_t * {
+        auto it = signal_by_name.find(name);
+        return (it == signal_by_name.end()) ? nullptr : it->second;
+    };
+
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::istringstream item(line);
+        std::string keyword, name;
+        uint64_t delay;
+
+        item >> keyword;
+        if (keyword == "time") {
+            if (saved_time != UINT64_MAX || !(item >> saved_time))
+                return false;
+        } else if (keyword == "signal") {
+            // Values are parsed again when installed.
+            item >> std::quoted(name);
+            signal_base_t *sig = find_signal(name);
+            if (sig == nullptr || !sig->restore_value(item, false) ||
+                !values.emplace(sig, line).second)
+                return false;
+        } else if (keyword == "active") {
+            item >> std::quoted(name);
+            signal_base_t *sig = find_signal(name);
+            if (sig == nullptr || std::find(active.begin(), active.end(), sig) != active.end())
+                return false;
+            active.push_back(sig);
+        } else if (keyword == "assign") {
+            // Signal must be restored before its waveform.
+            item >> std::quoted(name) >> delay;
+            signal_base_t *sig = find_signal(name);
+            if (sig == nullptr || values.count(sig) == 0 ||
+                !sig->restore_transaction(*this, item, delay, false))
+                return false;
+            assigns.emplace_back(sig, line);
+        } else if (!keyword.empty()) {
+            return false;
+        }
+        if (item.fail())
+            return false;
+    }
+
+    // Time is set only before the start: events, queued so far, are relative to it.
+    if (saved_time == UINT64_MAX || (started && saved_time != time_ticks))
+        return false;
+    if (!started) {
+        pacing.base_ticks += saved_time - time_ticks;
+        time_ticks = saved_time;
+    }
+
+    // Pending changes of the restored signals are replaced by the saved ones.
+    for (signal_base_t **ptr = &active_signals; *ptr != nullptr;) {
+        signal_base_t *sig = *ptr;
+        if (values.count(sig) != 0) {
+            *ptr = sig->next;
+            sig->next = nullptr;
+            sig->is_active = false;
+        } else {
+            ptr = &sig->next;
+        }
+    }
+
+    // Install the saved values, and rebuild the waveforms.
+    for (auto &item : values) {
+        std::istringstream args(item.second);
+        std::string keyword, name;
+        args >> keyword >> std::quoted(name);
+        item.first->restore_value(args, true);
+        cancel_transactions(*item.first, 0);
+    }
+    for (auto &item : assigns) {
+        std::istringstream args(item.second);
+        std::string keyword, name;
+        uint64_t delay;
+        args >> keyword >> std::quoted(name) >> delay;
+        item.first->restore_transaction(*this, args, delay, true);
+    }
+    for (auto it = active.rbegin(); it != active.rend(); ++it) {
+        (*it)->is_active = true;
+        (*it)->next = active_signals;
+        active_signals = *it;
+    }
+
+    return true;
+}